@@ -25,382 +25,6126 @@
 #include <QRadioButton>
 #include <QThreadPool>
 #include <QRunnable>
+#include <QSettings>
+#include <QFileInfo>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QSemaphore>
+#include <QFile>
+#include <QSaveFile>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QPointer>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QDateTime>
+#include <QWaitCondition>
+#include <QProcess>
+#include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include <bit>
+#include <map>
+#include <deque>
+#include <chrono>
+#include <csignal>
+#include <list>
+#include <numeric>
+#include <type_traits>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <cstdio>
+#endif
+
+#ifdef HAVE_IO_URING
+#include <liburing.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
 
 // GDAL Headers
 #include "gdal_priv.h"
 #include "cpl_conv.h" // for CPLMalloc()
 #include "cpl_string.h" // for CSLTokenizeString2
+#include "cpl_virtualmem.h"
+#include "gdal_alg.h"       // for the GenImgProj/approx transformers
+#include "gdal_utils.h"     // for GDALBuildVRT
+#include "ogr_spatialref.h"
+
+// Resampling used when output pixels do not map 1:1 onto input pixels;
+// reprojection supports nearest and bilinear, resizing supports all of them
+enum class ResamplingMethod { Nearest, Bilinear, Cubic, Lanczos, Average };
+
+// How overlapping mosaic inputs combine; nodata never takes part
+enum class CompositeRule { First, Last, Minimum, Maximum, Mean };
+
+// Order windows are visited in. Auto lets the planner pick the one that
+// decodes the fewest input blocks for the GDAL block cache it has
+enum class TraversalOrder { Auto, RowMajor, TileRowMajor, Morton, Hilbert };
+
+// Engine settings collected from the GUI for one conversion
+struct ConversionSettings
+{
+    int blockSize = 256;
+    bool autotune = false;
+    int prefetchDistance = 0;   // windows to hint ahead of the read stage, 0 = off
+    bool useIoUring = false;    // read uncompressed GTiff blocks with io_uring
+    bool memoryMapInput = false; // read uncompressed inputs in place, without copies
+    bool numaAware = false;      // one pinned pool and node-local buffers per NUMA node
+    TraversalOrder traversal = TraversalOrder::Auto;
+
+    // Reprojection; an empty CRS keeps the input grid, resolution 0 lets GDAL choose
+    QString targetSrs;
+    double targetResolution = 0.0;
+    ResamplingMethod resampling = ResamplingMethod::Nearest;
+
+    // Output size; an explicit width or height wins over the scale factor and
+    // a missing one follows the aspect ratio. 1.0 and 0 x 0 keep the size
+    double outputScale = 1.0;
+    int outputWidth = 0;
+    int outputHeight = 0;
+    ResamplingMethod resizeResampling = ResamplingMethod::Average;
+
+    // ';'-separated band-math expressions, one Float32 output band each; empty = off
+    QString bandExpression;
+
+    // Input bands to process, in output order, e.g. "4,3,2" or "1-3"; empty = all
+    QString bandSelection;
+
+    // Area to extract, either "xoff,yoff,xsize,ysize" in pixels or
+    // "minx,miny,maxx,maxy" in input CRS units; empty = the whole input
+    enum SubsetMode { NoSubset, PixelWindow, BoundingBox };
+    SubsetMode subsetMode = NoSubset;
+    QString subset;
+
+    // With two or more files the input is their mosaic; the first file sets
+    // the band layout and resolution
+    QStringList mosaicInputs;
+    CompositeRule compositeRule = CompositeRule::First;
+
+    // Web map tile pyramid written instead of one file; the output path is
+    // its folder. maxZoom -1 picks the zoom matching the input resolution
+    enum TileMode { NoTiles, XyzTiles, TmsTiles };
+    TileMode tileMode = NoTiles;
+    QString tileFormat = "PNG";
+    int minZoom = 0;
+    int maxZoom = -1;
+
+    // Output split into a grid of files, either columns x rows or square
+    // chunks of splitChunkSize pixels (which wins when set); 1 x 1 = one file
+    int splitColumns = 1;
+    int splitRows = 1;
+    int splitChunkSize = 0;
+
+    // Update an existing output in place, rewriting only windows whose input changed
+    bool incremental = false;
+
+    // Shard shardIndex of shardCount writes only its band of output rows;
+    // mergeShards() assembles the part files. 1 shard = the whole output
+    int shardIndex = 0;
+    int shardCount = 1;
+
+    // Named GDAL configuration profile (see gdalProfiles()); empty = GDAL defaults
+    QString gdalProfile;
+};
+
+// GDAL progress callback that stops the operation once the job's running
+// flag drops. GDAL polls it between blocks, so a long RasterIO or
+// CreateCopy gives up within one block of a cancel instead of finishing
+static int continueWhileRunning(double, const char*, void* running)
+{
+    return static_cast<const std::atomic<bool>*>(running)->load() ? TRUE : FALSE;
+}
+
+// RasterIO arguments that make the call cancellable through running
+static GDALRasterIOExtraArg cancellableIO(const std::atomic<bool>* running)
+{
+    GDALRasterIOExtraArg extraArg;
+    INIT_RASTERIO_EXTRA_ARG(extraArg);
+    if (running)
+    {
+        extraArg.pfnProgress = continueWhileRunning;
+        extraArg.pProgressData = const_cast<std::atomic<bool>*>(running);
+    }
+    return extraArg;
+}
+
+// Output rows [first, last) written by one shard. Boundaries fall on
+// multiples of 256 rows so parts line up with tiles; trailing shards of a
+// small output can be empty
+static std::pair<int, int> shardRows(int height, int index, int count)
+{
+    const int align = 256;
+    int units = (height + align - 1) / align;
+    int first = std::min(height, static_cast<int>(static_cast<qint64>(units) * index / count) * align);
+    int last = std::min(height, static_cast<int>(static_cast<qint64>(units) * (index + 1) / count) * align);
+    return {first, last};
+}
+
+// Written by a shard with no output rows in place of its part, so the
+// merge can tell an empty shard from a lost one
+static QString emptyShardMarker(const QString& part)
+{
+    return part + ".empty";
+}
+
+// Assembles shard part files into one output: a VRT over the parts, or a
+// copy of that VRT into any other driver (e.g. one GTiff or COG). Every
+// part must exist or carry an empty-shard marker. The copy stops, and its
+// partial output is deleted, once running drops
+static bool mergeShards(const QStringList& parts, const QString& output, const QString& driverName, const QMap<QString, QString>& options, QString& error,
+                        const std::atomic<bool>* running = nullptr)
+{
+    CPLStringList sources;
+    for (const QString& part : parts)
+    {
+        if (QFileInfo::exists(part))
+            sources.AddString(part.toStdString().c_str());
+        else if (!QFileInfo::exists(emptyShardMarker(part)))
+        {
+            error = "Shard part missing: " + part;
+            return false;
+        }
+    }
+    if (sources.Count() == 0)
+    {
+        error = "No shard parts to merge.";
+        return false;
+    }
+
+    bool toVrt = driverName.compare("VRT", Qt::CaseInsensitive) == 0;
+    int usageError = FALSE;
+    GDALDatasetH hVrt = GDALBuildVRT(toVrt ? output.toStdString().c_str() : "", sources.Count(), nullptr, sources.List(), nullptr, &usageError);
+    if (!hVrt)
+    {
+        error = "Failed to assemble the shard parts.\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+        return false;
+    }
+    if (toVrt)
+    {
+        GDALClose(hVrt);
+        return true;
+    }
+
+    GDALDriver* poDriver = GetGDALDriverManager()->GetDriverByName(driverName.toStdString().c_str());
+    if (!poDriver)
+    {
+        GDALClose(hVrt);
+        error = "Output driver not available: " + driverName;
+        return false;
+    }
+
+    char** papszOptions = nullptr;
+    for (auto it = options.begin(); it != options.end(); ++it)
+        papszOptions = CSLSetNameValue(papszOptions, it.key().toStdString().c_str(), it.value().toStdString().c_str());
+    GDALDataset* poOut = poDriver->CreateCopy(output.toStdString().c_str(), GDALDataset::FromHandle(hVrt), FALSE, papszOptions,
+                                              running ? continueWhileRunning : nullptr, const_cast<std::atomic<bool>*>(running));
+    CSLDestroy(papszOptions);
+    GDALClose(hVrt);
+    if (!poOut && running && !running->load())
+    {
+        if (QFileInfo::exists(output))
+            poDriver->Delete(output.toStdString().c_str());
+        error = "Merge cancelled.";
+        return false;
+    }
+    if (!poOut)
+    {
+        error = "Failed to write the merged output.\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+        return false;
+    }
+    GDALClose(poOut);
+    return true;
+}
+
+// A coherent set of GDAL configuration options tuned for one kind of
+// storage or host. cacheMB sizes the block cache, 0 leaves it alone
+struct GdalProfile
+{
+    QString name;
+    QString description;
+    std::vector<std::pair<QString, QString>> options;
+    qint64 cacheMB = 0;
+
+    // Codec threads asked for through GDAL_NUM_THREADS, or 0 when the
+    // profile leaves them alone
+    int codecThreads() const
+    {
+        for (const auto& [key, value] : options)
+        {
+            if (key == "GDAL_NUM_THREADS")
+                return value.compare("ALL_CPUS", Qt::CaseInsensitive) == 0 ? QThread::idealThreadCount() : std::max(1, value.toInt());
+        }
+        return 0;
+    }
+
+    // The options as set when GDAL_NUM_THREADS is capped at maxThreads
+    // (0 = not capped)
+    std::vector<std::pair<QString, QString>> appliedOptions(int maxThreads = 0) const
+    {
+        std::vector<std::pair<QString, QString>> applied = options;
+        for (auto& [key, value] : applied)
+        {
+            if (key == "GDAL_NUM_THREADS" && maxThreads > 0)
+                value = QString::number(std::min(codecThreads(), maxThreads));
+        }
+        return applied;
+    }
+
+    // "KEY=VALUE, ..." of what is applied, for logs and telemetry
+    QString describe(int maxThreads = 0, bool withCache = true) const
+    {
+        QStringList items;
+        for (const auto& [key, value] : appliedOptions(maxThreads))
+            items << key + "=" + value;
+        if (withCache && cacheMB > 0)
+            items << QString("GDAL_CACHEMAX=%1MB").arg(cacheMB);
+        return items.join(", ");
+    }
+};
+
+static const std::vector<GdalProfile>& gdalProfiles()
+{
+    static const std::vector<GdalProfile> profiles = {
+        {"nvme-bulk", "Local NVMe: large swaths, direct I/O, multi-threaded codecs, no VSI cache",
+         {{"GDAL_NUM_THREADS", "ALL_CPUS"}, {"GDAL_SWATH_SIZE", "1073741824"}, {"GTIFF_DIRECT_IO", "YES"}, {"VSI_CACHE", "FALSE"}},
+         2048},
+        {"nfs", "Network filesystems: no directory scans on open, a VSI read cache, moderate swaths",
+         {{"GDAL_NUM_THREADS", "ALL_CPUS"}, {"GDAL_DISABLE_READDIR_ON_OPEN", "EMPTY_DIR"}, {"VSI_CACHE", "TRUE"},
+          {"VSI_CACHE_SIZE", "268435456"}, {"GDAL_SWATH_SIZE", "268435456"}},
+         1024},
+        {"low-memory", "Small hosts: a small block cache and swaths, single-threaded codecs",
+         {{"GDAL_NUM_THREADS", "1"}, {"GDAL_SWATH_SIZE", "16777216"}, {"VSI_CACHE", "FALSE"}},
+         64},
+    };
+    return profiles;
+}
+
+static const GdalProfile* findGdalProfile(const QString& name)
+{
+    for (const GdalProfile& profile : gdalProfiles())
+    {
+        if (profile.name.compare(name, Qt::CaseInsensitive) == 0)
+            return &profile;
+    }
+    return nullptr;
+}
+
+// Applies a profile's options to the calling thread for the scope's
+// lifetime, so concurrent jobs in one process keep their own settings.
+// The block cache is process-wide and is only resized when asked to;
+// maxThreads > 0 caps GDAL_NUM_THREADS, e.g. at a daemon job's share
+class ScopedGdalConfig
+{
+public:
+    ScopedGdalConfig(const GdalProfile& profile, bool resizeCache, int maxThreads = 0)
+    {
+        for (const auto& [key, value] : profile.appliedOptions(maxThreads))
+        {
+            std::string name = key.toStdString();
+            const char* previous = CPLGetThreadLocalConfigOption(name.c_str(), nullptr);
+            saved.push_back({name, previous ? std::optional<std::string>(previous) : std::nullopt});
+            CPLSetThreadLocalConfigOption(name.c_str(), value.toStdString().c_str());
+        }
+        if (resizeCache && profile.cacheMB > 0)
+        {
+            previousCache = GDALGetCacheMax64();
+            GDALSetCacheMax64(profile.cacheMB << 20);
+        }
+    }
+
+    ~ScopedGdalConfig()
+    {
+        for (auto it = saved.rbegin(); it != saved.rend(); ++it)
+            CPLSetThreadLocalConfigOption(it->first.c_str(), it->second ? it->second->c_str() : nullptr);
+        if (previousCache > 0)
+            GDALSetCacheMax64(previousCache);
+    }
+
+    ScopedGdalConfig(const ScopedGdalConfig&) = delete;
+    ScopedGdalConfig& operator=(const ScopedGdalConfig&) = delete;
+
+private:
+    std::vector<std::pair<std::string, std::optional<std::string>>> saved;
+    GIntBig previousCache = 0;
+};
+
+// A rectangular window of the raster handled as one unit of work
+struct BlockWindow
+{
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Read-only view of one band's pixels inside a window
+struct BandView
+{
+    const char* data = nullptr;
+    GSpacing pixelSpace = 0;
+    GSpacing lineSpace = 0;
+};
+
+// Band buffers for one window, filled by the read stage
+struct BlockBuffer
+{
+    BlockWindow window;
+    std::vector<std::vector<char>> bandData;
+    std::vector<GDALDataType> bandTypes;
+
+    // Set instead of bandData when the input is read in place (memory-mapped);
+    // these pixels are read-only and may be strided
+    std::vector<BandView> mappedBands;
+
+    // Output window of each processing stage, in order; the last one is written
+    std::vector<BlockWindow> stageWindows;
+
+    int bandCount() const { return static_cast<int>(bandTypes.size()); }
+
+    BandView band(int index) const
+    {
+        if (!mappedBands.empty())
+            return mappedBands[index];
+
+        GSpacing nTypeSize = GDALGetDataTypeSizeBytes(bandTypes[index]);
+        return {bandData[index].data(), nTypeSize, nTypeSize * window.width};
+    }
+};
+
+// Per-block float32 kernels behind a pluggable backend. Every backend must
+// be bit-identical to the scalar reference, so vector code performs the same
+// IEEE operations in the same order per element and never fuses multiply-add
+class ComputeBackend
+{
+public:
+    enum BinaryOp { Add, Subtract, Multiply, Divide, Minimum, Maximum };
+
+    virtual ~ComputeBackend() = default;
+
+    virtual const char* name() const = 0;
+
+    // out[i] = a[i] op b[i]
+    virtual void binary(BinaryOp op, const float* a, const float* b, float* out, size_t n) const = 0;
+
+    // out[i] = sum over k of weights[k] * rows[k][i], accumulated in k order
+    virtual void weightedSum(const float* const* rows, const float* weights, int taps, float* out, size_t n) const = 0;
+
+    static const ComputeBackend& scalar();
+    static const ComputeBackend& simd();
+
+protected:
+    // min/max follow the x86 convention: the second operand wins on NaN
+    static float apply(BinaryOp op, float a, float b)
+    {
+        switch (op)
+        {
+        case Add: return a + b;
+        case Subtract: return a - b;
+        case Multiply: return a * b;
+        case Divide: return a / b;
+        case Minimum: return a < b ? a : b;
+        case Maximum: return a > b ? a : b;
+        }
+        return 0.0f;
+    }
+
+    static void binaryTail(BinaryOp op, const float* a, const float* b, float* out, size_t from, size_t n)
+    {
+        for (size_t i = from; i < n; ++i)
+            out[i] = apply(op, a[i], b[i]);
+    }
+
+    static void weightedSumTail(const float* const* rows, const float* weights, int taps, float* out, size_t from, size_t n)
+    {
+        for (size_t i = from; i < n; ++i)
+        {
+            float sum = 0.0f;
+            for (int k = 0; k < taps; ++k)
+                sum = sum + weights[k] * rows[k][i];
+            out[i] = sum;
+        }
+    }
+};
+
+// Reference implementation; the other backends are validated against it
+class ScalarBackend : public ComputeBackend
+{
+public:
+    const char* name() const override { return "scalar"; }
+
+    void binary(BinaryOp op, const float* a, const float* b, float* out, size_t n) const override
+    {
+        binaryTail(op, a, b, out, 0, n);
+    }
+
+    void weightedSum(const float* const* rows, const float* weights, int taps, float* out, size_t n) const override
+    {
+        weightedSumTail(rows, weights, taps, out, 0, n);
+    }
+};
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIMD_TARGET(isa)
+#endif
+
+// Generates an x86 backend from one set of intrinsics per vector width
+#define DEFINE_X86_BACKEND(Class, Label, Isa, Vec, Width, Load, Store, Set1, AddOp, SubOp, MulOp, DivOp, MinOp, MaxOp, Zero) \
+class Class : public ComputeBackend \
+{ \
+public: \
+    const char* name() const override { return Label; } \
+    \
+    SIMD_TARGET(Isa) void binary(BinaryOp op, const float* a, const float* b, float* out, size_t n) const override \
+    { \
+        size_t i = 0; \
+        for (; i + Width <= n; i += Width) \
+        { \
+            Vec va = Load(a + i); \
+            Vec vb = Load(b + i); \
+            Vec r; \
+            switch (op) \
+            { \
+            case Add: r = AddOp(va, vb); break; \
+            case Subtract: r = SubOp(va, vb); break; \
+            case Multiply: r = MulOp(va, vb); break; \
+            case Divide: r = DivOp(va, vb); break; \
+            case Minimum: r = MinOp(va, vb); break; \
+            default: r = MaxOp(va, vb); break; \
+            } \
+            Store(out + i, r); \
+        } \
+        binaryTail(op, a, b, out, i, n); \
+    } \
+    \
+    SIMD_TARGET(Isa) void weightedSum(const float* const* rows, const float* weights, int taps, float* out, size_t n) const override \
+    { \
+        size_t i = 0; \
+        for (; i + Width <= n; i += Width) \
+        { \
+            Vec sum = Zero(); \
+            for (int k = 0; k < taps; ++k) \
+                sum = AddOp(sum, MulOp(Set1(weights[k]), Load(rows[k] + i))); \
+            Store(out + i, sum); \
+        } \
+        weightedSumTail(rows, weights, taps, out, i, n); \
+    } \
+};
+
+DEFINE_X86_BACKEND(Avx2Backend, "AVX2", "avx2", __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps,
+                   _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_div_ps, _mm256_min_ps, _mm256_max_ps, _mm256_setzero_ps)
+DEFINE_X86_BACKEND(Avx512Backend, "AVX-512", "avx512f", __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps,
+                   _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps, _mm512_div_ps, _mm512_min_ps, _mm512_max_ps, _mm512_setzero_ps)
+
+#undef DEFINE_X86_BACKEND
+
+// OS support for the wider registers is checked as well as the CPU flags
+static bool cpuSupports(const char* isa)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (strcmp(isa, "avx512f") == 0)
+        return __builtin_cpu_supports("avx512f");
+    return __builtin_cpu_supports("avx2");
+#else
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave)
+        return false;
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (strcmp(isa, "avx512f") == 0)
+        return (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+    return (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+#endif
+}
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+class NeonBackend : public ComputeBackend
+{
+public:
+    const char* name() const override { return "NEON"; }
+
+    void binary(BinaryOp op, const float* a, const float* b, float* out, size_t n) const override
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            float32x4_t va = vld1q_f32(a + i);
+            float32x4_t vb = vld1q_f32(b + i);
+            float32x4_t r;
+            switch (op)
+            {
+            case Add: r = vaddq_f32(va, vb); break;
+            case Subtract: r = vsubq_f32(va, vb); break;
+            case Multiply: r = vmulq_f32(va, vb); break;
+            case Divide: r = vdivq_f32(va, vb); break;
+            // vminq/vmaxq propagate NaN, so select explicitly to match the reference
+            case Minimum: r = vbslq_f32(vcltq_f32(va, vb), va, vb); break;
+            default: r = vbslq_f32(vcgtq_f32(va, vb), va, vb); break;
+            }
+            vst1q_f32(out + i, r);
+        }
+        binaryTail(op, a, b, out, i, n);
+    }
+
+    void weightedSum(const float* const* rows, const float* weights, int taps, float* out, size_t n) const override
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            float32x4_t sum = vdupq_n_f32(0.0f);
+            for (int k = 0; k < taps; ++k)
+                sum = vaddq_f32(sum, vmulq_f32(vdupq_n_f32(weights[k]), vld1q_f32(rows[k] + i)));
+            vst1q_f32(out + i, sum);
+        }
+        weightedSumTail(rows, weights, taps, out, i, n);
+    }
+};
+#endif
+
+const ComputeBackend& ComputeBackend::scalar()
+{
+    static const ScalarBackend backend;
+    return backend;
+}
+
+// Widest vector unit available at run time, falling back to the reference
+const ComputeBackend& ComputeBackend::simd()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    static const Avx512Backend avx512;
+    static const Avx2Backend avx2;
+    static const bool hasAvx512 = cpuSupports("avx512f");
+    static const bool hasAvx2 = cpuSupports("avx2");
+    if (hasAvx512)
+        return avx512;
+    if (hasAvx2)
+        return avx2;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    static const NeonBackend neon;
+    return neon;
+#endif
+    return scalar();
+}
+
+// Size, georeferencing and band layout of a raster as it flows through the stages
+struct RasterGrid
+{
+    int xSize = 0;
+    int ySize = 0;
+    bool hasGeoTransform = false;
+    double geoTransform[6] = {0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+    std::string projection;
+    std::vector<GDALDataType> bandTypes;
+    std::vector<std::optional<double>> bandNoData;
+
+    // Georeferenced without rotation, as GDALBuildVRT requires of its sources
+    bool northUp() const
+    {
+        return hasGeoTransform && geoTransform[2] == 0.0 && geoTransform[4] == 0.0;
+    }
+
+    // Band i of the grid is dataset band bands[i] (1-based)
+    static RasterGrid fromDataset(GDALDataset* poDataset, const std::vector<int>& bands)
+    {
+        RasterGrid grid;
+        grid.xSize = poDataset->GetRasterXSize();
+        grid.ySize = poDataset->GetRasterYSize();
+        grid.hasGeoTransform = poDataset->GetGeoTransform(grid.geoTransform) == CE_None;
+        const char* projection = poDataset->GetProjectionRef();
+        grid.projection = projection ? projection : "";
+        for (int bandIndex : bands)
+        {
+            GDALRasterBand* poBand = poDataset->GetRasterBand(bandIndex);
+            int bHasNoData = FALSE;
+            double noData = poBand->GetNoDataValue(&bHasNoData);
+            grid.bandTypes.push_back(poBand->GetRasterDataType());
+            grid.bandNoData.push_back(bHasNoData ? std::optional<double>(noData) : std::nullopt);
+        }
+        return grid;
+    }
+};
+
+// One processing step applied to a window in the worker pool. A stage turns
+// the buffer's current window into its output window; the planner asks each
+// stage, from the last back to the first, which input window it needs
+class BlockStage
+{
+public:
+    virtual ~BlockStage() = default;
+
+    // Grid produced by this stage from its input grid
+    virtual RasterGrid outputGrid(const RasterGrid& input) const { return input; }
+
+    // Input window needed to produce an output window; width 0 means no input
+    // pixels contribute. Called from the planning thread only
+    virtual BlockWindow inputWindow(const BlockWindow& output) { return output; }
+
+    // Replaces the buffer contents with the output window; runs on pool threads
+    virtual void run(BlockBuffer& buffer, const BlockWindow& output, const ComputeBackend& backend) = 0;
+
+    // Why a run could not produce its window, empty while all have; checked
+    // after each batch
+    virtual QString failure() const { return QString(); }
+};
+
+// Process data in worker threads
+class BlockProcessor : public QRunnable
+{
+public:
+    // done, when given, is released once the window is finished, for
+    // waiting on one batch in a pool other jobs share; cpus pins the pool
+    // thread to one NUMA node
+    BlockProcessor(BlockBuffer& buffer, const std::vector<std::unique_ptr<BlockStage>>& stages, const ComputeBackend& backend, std::atomic<bool>* isConverting,
+                   QSemaphore* done = nullptr, const std::vector<int>* cpus = nullptr)
+        : buffer(buffer), stages(stages), backend(backend), isConverting(isConverting), done(done), cpus(cpus)
+    {
+        setAutoDelete(true);
+    }
+
+    void run() override;
+
+private:
+    BlockBuffer& buffer;
+    const std::vector<std::unique_ptr<BlockStage>>& stages;
+    const ComputeBackend& backend;
+    std::atomic<bool>* isConverting;
+    QSemaphore* done;
+    const std::vector<int>* cpus;
+};
+
+// Block processing spread over NUMA nodes (Linux; a no-op elsewhere and on
+// single-node hosts). Each node has its own pool whose threads pin
+// themselves to the node's CPUs and takes a contiguous range of every
+// batch's windows. Window buffers belong to a batch slot and are first
+// touched by a thread of the slot's node, so the kernel places their
+// pages in that node's memory; slots keep their buffers from batch to
+// batch, and the reader then fills memory that is local to the threads
+// that process it
+class NumaPlacement
+{
+public:
+    static std::unique_ptr<NumaPlacement> create(int threads)
+    {
+        std::vector<std::vector<int>> nodeCpus = topology();
+        if (nodeCpus.size() < 2 || threads < 2)
+            return nullptr;
+        nodeCpus.resize(std::min(nodeCpus.size(), static_cast<size_t>(threads)));
+
+        // Threads per node in proportion to its CPUs, at least one each
+        size_t totalCpus = 0;
+        for (const std::vector<int>& cpus : nodeCpus)
+            totalCpus += cpus.size();
+
+        std::unique_ptr<NumaPlacement> placement(new NumaPlacement());
+        int assigned = 0;
+        for (const std::vector<int>& cpus : nodeCpus)
+        {
+            Node node;
+            node.cpus = cpus;
+            node.threads = std::max<int>(1, static_cast<int>(threads * cpus.size() / totalCpus));
+            assigned += node.threads;
+            placement->nodes.push_back(std::move(node));
+        }
+        for (size_t i = 0; assigned != threads; i = (i + 1) % placement->nodes.size())
+        {
+            Node& node = placement->nodes[i];
+            int step = assigned < threads ? 1 : (node.threads > 1 ? -1 : 0);
+            node.threads += step;
+            assigned += step;
+        }
+
+        for (int n = 0; n < static_cast<int>(placement->nodes.size()); ++n)
+        {
+            Node& node = placement->nodes[n];
+            node.pool = std::make_unique<QThreadPool>();
+            node.pool->setMaxThreadCount(node.threads);
+            placement->slotNode.insert(placement->slotNode.end(), node.threads, n);
+        }
+        return placement;
+    }
+
+    // e.g. "2 nodes, 8 + 8 threads"
+    QString describe() const
+    {
+        QStringList threads;
+        for (const Node& node : nodes)
+            threads << QString::number(node.threads);
+        return QString("%1 nodes, %2 threads").arg(nodes.size()).arg(threads.join(" + "));
+    }
+
+    // Moves the batch's windows into their slots, keeping each slot's
+    // buffers, and grows on its own node any buffer too small for them
+    void prepare(std::vector<BlockBuffer>& batch, std::vector<BlockBuffer>& plans, int first, int nBatch, const std::vector<GDALDataType>& types)
+    {
+        if (batch.size() < slotNode.size())
+            batch.resize(slotNode.size());
+
+        QSemaphore touched;
+        int pending = 0;
+        for (int i = 0; i < nBatch; ++i)
+        {
+            std::vector<std::vector<char>> data = std::move(batch[i].bandData);
+            batch[i] = std::move(plans[first + i]);
+            batch[i].bandData = std::move(data);
+
+            size_t pixels = static_cast<size_t>(std::max(0, batch[i].window.width)) * std::max(0, batch[i].window.height);
+            bool fits = batch[i].bandData.size() == types.size();
+            for (size_t b = 0; fits && b < types.size(); ++b)
+                fits = batch[i].bandData[b].capacity() >= pixels * GDALGetDataTypeSizeBytes(types[b]);
+            if (fits)
+                continue;
+
+            const Node& node = nodes[slotNode[i]];
+            node.pool->start(new TouchTask(batch[i], types, pixels, node.cpus, touched));
+            ++pending;
+        }
+        touched.acquire(pending);
+    }
+
+    void start(int slot, BlockBuffer& buffer, const std::vector<std::unique_ptr<BlockStage>>& stages, const ComputeBackend& backend,
+               std::atomic<bool>* isConverting, QSemaphore* done)
+    {
+        const Node& node = nodes[slotNode[slot]];
+        node.pool->start(new BlockProcessor(buffer, stages, backend, isConverting, done, &node.cpus));
+    }
+
+    // Pins the calling pool thread once; its pool always serves one node
+    static void pinThread(const std::vector<int>& cpus)
+    {
+#ifdef __linux__
+        thread_local const std::vector<int>* pinned = nullptr;
+        if (pinned == &cpus)
+            return;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+            CPU_SET(cpu, &set);
+        sched_setaffinity(0, sizeof(set), &set);
+        pinned = &cpus;
+#else
+        (void)cpus;
+#endif
+    }
+
+private:
+    struct Node
+    {
+        std::vector<int> cpus;
+        int threads = 0;
+        std::unique_ptr<QThreadPool> pool;
+    };
+
+    class TouchTask : public QRunnable
+    {
+    public:
+        TouchTask(BlockBuffer& buffer, const std::vector<GDALDataType>& types, size_t pixels, const std::vector<int>& cpus, QSemaphore& done)
+            : buffer(buffer), types(types), pixels(pixels), cpus(cpus), done(done) {}
+
+        void run() override
+        {
+            pinThread(cpus);
+            buffer.bandData.resize(types.size());
+            for (size_t b = 0; b < types.size(); ++b)
+            {
+                // A fresh vector, zero-filled here, so its pages are this node's
+                size_t bytes = pixels * GDALGetDataTypeSizeBytes(types[b]);
+                if (buffer.bandData[b].capacity() < bytes)
+                    std::vector<char>(bytes).swap(buffer.bandData[b]);
+            }
+            done.release();
+        }
+
+    private:
+        BlockBuffer& buffer;
+        const std::vector<GDALDataType>& types;
+        size_t pixels;
+        const std::vector<int>& cpus;
+        QSemaphore& done;
+    };
+
+    // CPUs of each node this process may run on, from sysfs
+    static std::vector<std::vector<int>> topology()
+    {
+        std::vector<std::vector<int>> result;
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+            return result;
+
+        QDir nodeDir("/sys/devices/system/node");
+        for (const QString& name : nodeDir.entryList({"node*"}, QDir::Dirs, QDir::Name))
+        {
+            QFile file(nodeDir.filePath(name + "/cpulist"));
+            if (!file.open(QIODevice::ReadOnly))
+                continue;
+
+            // e.g. "0-15,32-47"
+            std::vector<int> cpus;
+            for (const QByteArray& range : file.readAll().trimmed().split(','))
+            {
+                QList<QByteArray> ends = range.split('-');
+                int low = ends[0].toInt();
+                int high = ends.size() > 1 ? ends[1].toInt() : low;
+                for (int cpu = low; cpu <= high && cpu < CPU_SETSIZE; ++cpu)
+                {
+                    if (CPU_ISSET(cpu, &allowed))
+                        cpus.push_back(cpu);
+                }
+            }
+            if (!cpus.empty())
+                result.push_back(std::move(cpus));
+        }
+#endif
+        return result;
+    }
+
+    std::vector<Node> nodes;
+    std::vector<int> slotNode; // node of each batch slot, in contiguous runs
+};
+
+void BlockProcessor::run()
+{
+    if (cpus)
+        NumaPlacement::pinThread(*cpus);
+
+    for (size_t i = 0; i < stages.size() && isConverting->load(); ++i)
+        stages[i]->run(buffer, buffer.stageWindows[i], backend);
+
+    if (done)
+        done->release();
+}
+
+// Composites many source files onto one grid; always the first stage. The
+// grid is the union of the source footprints at the first source's
+// resolution, and a bucket grid over it indexes which sources overlap a
+// window. The stage reads its own input: each pool thread opens its own
+// handles to the sources it touches, as GDAL datasets are not thread-safe
+class MosaicStage : public BlockStage
+{
+public:
+    static std::unique_ptr<MosaicStage> create(const QStringList& paths, const RasterGrid& first, const std::vector<int>& bands,
+                                               CompositeRule rule, QString& error)
+    {
+        std::unique_ptr<MosaicStage> stage(new MosaicStage());
+        stage->bands = bands;
+        stage->rule = rule;
+        stage->grid = first;
+
+        int maxBand = bands.empty() ? 0 : *std::max_element(bands.begin(), bands.end());
+        OGRSpatialReference firstSrs;
+        if (!first.projection.empty())
+            firstSrs.SetFromUserInput(first.projection.c_str());
+
+        double minX = std::numeric_limits<double>::max();
+        double maxY = std::numeric_limits<double>::lowest();
+        double maxX = std::numeric_limits<double>::lowest();
+        double minY = std::numeric_limits<double>::max();
+        for (const QString& path : paths)
+        {
+            GDALDataset* poSource = static_cast<GDALDataset*>(GDALOpenEx(path.toStdString().c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY, nullptr, nullptr, nullptr));
+            if (!poSource)
+            {
+                error = "Failed to open mosaic input: " + path + "\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+                return nullptr;
+            }
+
+            Source source;
+            source.path = path.toStdString();
+            source.xSize = poSource->GetRasterXSize();
+            source.ySize = poSource->GetRasterYSize();
+            bool georeferenced = poSource->GetGeoTransform(source.geoTransform) == CE_None;
+            OGRSpatialReference srs;
+            const char* projection = poSource->GetProjectionRef();
+            if (projection && *projection)
+                srs.SetFromUserInput(projection);
+            for (int band : bands)
+            {
+                if (band > poSource->GetRasterCount())
+                    break;
+                int bHasNoData = FALSE;
+                double noData = poSource->GetRasterBand(band)->GetNoDataValue(&bHasNoData);
+                source.noData.push_back(bHasNoData ? std::optional<double>(noData) : std::nullopt);
+            }
+            int nSourceBands = poSource->GetRasterCount();
+            GDALClose(poSource);
+
+            if (!georeferenced || source.geoTransform[1] <= 0.0 || source.geoTransform[5] >= 0.0 ||
+                source.geoTransform[2] != 0.0 || source.geoTransform[4] != 0.0)
+            {
+                error = "Mosaic inputs need north-up geotransforms: " + path;
+                return nullptr;
+            }
+            if (nSourceBands < maxBand)
+            {
+                error = QString("Mosaic input %1 has %2 band(s), %3 needed.").arg(path).arg(nSourceBands).arg(maxBand);
+                return nullptr;
+            }
+            if (!srs.IsSame(&firstSrs))
+            {
+                error = "Mosaic inputs must share one CRS: " + path;
+                return nullptr;
+            }
+
+            const double* gt = source.geoTransform;
+            minX = std::min({minX, gt[0], gt[0] + source.xSize * gt[1]});
+            maxX = std::max({maxX, gt[0], gt[0] + source.xSize * gt[1]});
+            minY = std::min({minY, gt[3], gt[3] + source.ySize * gt[5]});
+            maxY = std::max({maxY, gt[3], gt[3] + source.ySize * gt[5]});
+            stage->sources.push_back(std::move(source));
+        }
+
+        // North-up grid at the first source's pixel size
+        double resX = std::fabs(stage->sources[0].geoTransform[1]);
+        double resY = std::fabs(stage->sources[0].geoTransform[5]);
+        double geoTransform[6] = {minX, resX, 0.0, maxY, 0.0, -resY};
+        std::copy(geoTransform, geoTransform + 6, stage->grid.geoTransform);
+        stage->grid.hasGeoTransform = true;
+        stage->grid.xSize = std::max(1, static_cast<int>(std::ceil((maxX - minX) / resX - 1e-6)));
+        stage->grid.ySize = std::max(1, static_cast<int>(std::ceil((maxY - minY) / resY - 1e-6)));
+
+        for (Source& source : stage->sources)
+        {
+            // Footprint in mosaic pixel coordinates; x and y ranges are ordered
+            const double* gt = source.geoTransform;
+            double x0 = (gt[0] - minX) / resX;
+            double x1 = (gt[0] + source.xSize * gt[1] - minX) / resX;
+            double y0 = (maxY - gt[3]) / resY;
+            double y1 = (maxY - (gt[3] + source.ySize * gt[5])) / resY;
+            source.footprint[0] = std::min(x0, x1);
+            source.footprint[1] = std::min(y0, y1);
+            source.footprint[2] = std::max(x0, x1);
+            source.footprint[3] = std::max(y0, y1);
+        }
+        stage->buildIndex();
+        return stage;
+    }
+
+    ~MosaicStage() override
+    {
+        for (auto it = handles.begin(); it != handles.end(); ++it)
+        {
+            for (const std::pair<int, GDALDataset*>& handle : it.value())
+                GDALClose(handle.second);
+        }
+    }
+
+    int sourceCount() const { return static_cast<int>(sources.size()); }
+
+    // Source reads stop early once this drops
+    void setRunningFlag(const std::atomic<bool>* flag) { running = flag; }
+
+    RasterGrid outputGrid(const RasterGrid&) const override { return grid; }
+
+    QString failure() const override
+    {
+        if (!failed.load())
+            return QString();
+        QMutexLocker locker(&failureMutex);
+        return failureMessage;
+    }
+
+    // Nothing is read through the worker's input dataset
+    BlockWindow inputWindow(const BlockWindow&) override { return {}; }
+
+    void run(BlockBuffer& buffer, const BlockWindow& output, const ComputeBackend&) override
+    {
+        size_t nPixels = static_cast<size_t>(output.width) * output.height;
+        int nBands = static_cast<int>(bands.size());
+        std::vector<std::vector<double>> values(nBands, std::vector<double>(nPixels, 0.0));
+        std::vector<std::vector<int>> counts(nBands, std::vector<int>(nPixels, 0));
+        std::vector<double> pixels;
+
+        for (int index : overlapping(output))
+        {
+            if (running && !running->load())
+                break;
+
+            const Source& source = sources[index];
+            const double* fp = source.footprint;
+
+            // Mosaic pixels whose centres fall inside this source
+            int x0 = std::max(output.x, static_cast<int>(std::ceil(fp[0] - 0.5)));
+            int x1 = std::min(output.x + output.width, static_cast<int>(std::ceil(fp[2] - 0.5)));
+            int y0 = std::max(output.y, static_cast<int>(std::ceil(fp[1] - 0.5)));
+            int y1 = std::min(output.y + output.height, static_cast<int>(std::ceil(fp[3] - 0.5)));
+            if (x1 <= x0 || y1 <= y0)
+                continue;
+
+            GDALDataset* poSource = threadHandle(index);
+            if (!poSource)
+            {
+                fail("Failed to open mosaic input: " + QString::fromStdString(source.path) + "\nGDAL Error: " + QString(CPLGetLastErrorMsg()));
+                break;
+            }
+
+            // The matching source area, read at mosaic resolution
+            double scaleX = source.xSize / (fp[2] - fp[0]);
+            double scaleY = source.ySize / (fp[3] - fp[1]);
+            GDALRasterIOExtraArg extraArg = cancellableIO(running);
+            extraArg.bFloatingPointWindowValidity = TRUE;
+            extraArg.dfXOff = std::clamp((x0 - fp[0]) * scaleX, 0.0, static_cast<double>(source.xSize));
+            extraArg.dfYOff = std::clamp((y0 - fp[1]) * scaleY, 0.0, static_cast<double>(source.ySize));
+            extraArg.dfXSize = std::min((x1 - x0) * scaleX, source.xSize - extraArg.dfXOff);
+            extraArg.dfYSize = std::min((y1 - y0) * scaleY, source.ySize - extraArg.dfYOff);
+            int nXOff = static_cast<int>(extraArg.dfXOff);
+            int nYOff = static_cast<int>(extraArg.dfYOff);
+            int nXSize = std::max(1, std::min(source.xSize - nXOff, static_cast<int>(std::ceil(extraArg.dfXOff + extraArg.dfXSize)) - nXOff));
+            int nYSize = std::max(1, std::min(source.ySize - nYOff, static_cast<int>(std::ceil(extraArg.dfYOff + extraArg.dfYSize)) - nYOff));
+
+            int width = x1 - x0;
+            int height = y1 - y0;
+            pixels.resize(static_cast<size_t>(width) * height);
+            bool readFailed = false;
+            for (int b = 0; b < nBands; ++b)
+            {
+                CPLErr err = poSource->GetRasterBand(bands[b])->RasterIO(GF_Read, nXOff, nYOff, nXSize, nYSize, pixels.data(),
+                                                                         width, height, GDT_Float64, 0, 0, &extraArg);
+                if (err != CE_None)
+                {
+                    readFailed = true;
+                    break;
+                }
+
+                for (int row = 0; row < height; ++row)
+                {
+                    for (int col = 0; col < width; ++col)
+                    {
+                        double v = pixels[static_cast<size_t>(row) * width + col];
+                        if (std::isnan(v) || (source.noData[b] && v == *source.noData[b]))
+                            continue;
+                        size_t i = static_cast<size_t>(y0 - output.y + row) * output.width + (x0 - output.x + col);
+                        composite(values[b][i], counts[b][i], v);
+                    }
+                }
+            }
+
+            // A read aborted by the cancel is not a failure
+            if (readFailed)
+            {
+                if (!running || running->load())
+                    fail("Failed to read mosaic input: " + QString::fromStdString(source.path) + "\nGDAL Error: " + QString(CPLGetLastErrorMsg()));
+                break;
+            }
+        }
+
+        buffer.bandData.assign(nBands, std::vector<char>());
+        buffer.bandTypes = grid.bandTypes;
+        for (int b = 0; b < nBands; ++b)
+        {
+            double fill = grid.bandNoData[b].value_or(0.0);
+            for (size_t i = 0; i < nPixels; ++i)
+            {
+                if (counts[b][i] == 0)
+                    values[b][i] = fill;
+                else if (rule == CompositeRule::Mean)
+                    values[b][i] /= counts[b][i];
+            }
+
+            int nTypeSize = GDALGetDataTypeSizeBytes(grid.bandTypes[b]);
+            buffer.bandData[b].resize(nPixels * nTypeSize);
+            GDALCopyWords(values[b].data(), GDT_Float64, sizeof(double), buffer.bandData[b].data(), grid.bandTypes[b], nTypeSize, static_cast<int>(nPixels));
+        }
+        buffer.mappedBands.clear();
+        buffer.window = output;
+    }
+
+private:
+    struct Source
+    {
+        std::string path;
+        int xSize = 0;
+        int ySize = 0;
+        double geoTransform[6] = {};
+        double footprint[4] = {};   // minx, miny, maxx, maxy in mosaic pixels
+        std::vector<std::optional<double>> noData;
+    };
+
+    static constexpr int IndexCells = 64;
+
+    // Sources each pool thread keeps open; past this the least recently
+    // used one is closed, so large mosaics stay clear of the descriptor limit
+    static constexpr size_t MaxOpenPerThread = 64;
+
+    MosaicStage() = default;
+
+    // Keeps the first failure; the job fails after the batch
+    void fail(const QString& message)
+    {
+        QMutexLocker locker(&failureMutex);
+        if (!failed.exchange(true))
+            failureMessage = message;
+    }
+
+    void composite(double& value, int& count, double v) const
+    {
+        switch (rule)
+        {
+        case CompositeRule::First:
+            if (count == 0)
+                value = v;
+            break;
+        case CompositeRule::Last:
+            value = v;
+            break;
+        case CompositeRule::Minimum:
+            value = count == 0 ? v : std::min(value, v);
+            break;
+        case CompositeRule::Maximum:
+            value = count == 0 ? v : std::max(value, v);
+            break;
+        case CompositeRule::Mean:
+            value = count == 0 ? v : value + v;
+            break;
+        }
+        ++count;
+    }
+
+    void buildIndex()
+    {
+        cellWidth = std::max(1, (grid.xSize + IndexCells - 1) / IndexCells);
+        cellHeight = std::max(1, (grid.ySize + IndexCells - 1) / IndexCells);
+        cells.assign(static_cast<size_t>(IndexCells) * IndexCells, {});
+        for (int index = 0; index < static_cast<int>(sources.size()); ++index)
+        {
+            const double* fp = sources[index].footprint;
+            int cx0 = std::clamp(static_cast<int>(fp[0]) / cellWidth, 0, IndexCells - 1);
+            int cx1 = std::clamp(static_cast<int>(std::ceil(fp[2])) / cellWidth, 0, IndexCells - 1);
+            int cy0 = std::clamp(static_cast<int>(fp[1]) / cellHeight, 0, IndexCells - 1);
+            int cy1 = std::clamp(static_cast<int>(std::ceil(fp[3])) / cellHeight, 0, IndexCells - 1);
+            for (int cy = cy0; cy <= cy1; ++cy)
+            {
+                for (int cx = cx0; cx <= cx1; ++cx)
+                    cells[static_cast<size_t>(cy) * IndexCells + cx].push_back(index);
+            }
+        }
+    }
+
+    // Sources whose footprint touches the window, in input order
+    std::vector<int> overlapping(const BlockWindow& w) const
+    {
+        std::vector<int> result;
+        int cx0 = std::clamp(w.x / cellWidth, 0, IndexCells - 1);
+        int cx1 = std::clamp((w.x + w.width - 1) / cellWidth, 0, IndexCells - 1);
+        int cy0 = std::clamp(w.y / cellHeight, 0, IndexCells - 1);
+        int cy1 = std::clamp((w.y + w.height - 1) / cellHeight, 0, IndexCells - 1);
+        for (int cy = cy0; cy <= cy1; ++cy)
+        {
+            for (int cx = cx0; cx <= cx1; ++cx)
+            {
+                for (int index : cells[static_cast<size_t>(cy) * IndexCells + cx])
+                {
+                    const double* fp = sources[index].footprint;
+                    if (fp[0] < w.x + w.width && fp[2] > w.x && fp[1] < w.y + w.height && fp[3] > w.y)
+                        result.push_back(index);
+                }
+            }
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    GDALDataset* threadHandle(int index)
+    {
+        QMutexLocker locker(&handleMutex);
+        std::list<std::pair<int, GDALDataset*>>& threadHandles = handles[QThread::currentThread()];
+        for (auto it = threadHandles.begin(); it != threadHandles.end(); ++it)
+        {
+            if (it->first == index)
+            {
+                threadHandles.splice(threadHandles.begin(), threadHandles, it);
+                return it->second;
+            }
+        }
+
+        GDALDataset* poSource = static_cast<GDALDataset*>(GDALOpenEx(sources[index].path.c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY, nullptr, nullptr, nullptr));
+        if (!poSource)
+            return nullptr;
+        if (threadHandles.size() >= MaxOpenPerThread)
+        {
+            GDALClose(threadHandles.back().second);
+            threadHandles.pop_back();
+        }
+        threadHandles.emplace_front(index, poSource);
+        return poSource;
+    }
+
+    std::vector<Source> sources;
+    std::vector<int> bands;
+    CompositeRule rule = CompositeRule::First;
+    RasterGrid grid;
+    const std::atomic<bool>* running = nullptr;
+
+    int cellWidth = 1;
+    int cellHeight = 1;
+    std::vector<std::vector<int>> cells;
+
+    QMutex handleMutex;
+    QMap<QThread*, std::list<std::pair<int, GDALDataset*>>> handles;
+
+    std::atomic<bool> failed{false};
+    mutable QMutex failureMutex;
+    QString failureMessage;
+};
+
+// Restricts processing to a pixel window of the stage's input grid: a
+// subset crops the input (after a mosaic, if any) and a shard crops the
+// finished output to its row band. Only output windows are planned, so
+// blocks outside the window are never read, and running it just relabels
+// the buffer's window
+class CropStage : public BlockStage
+{
+public:
+    explicit CropStage(const BlockWindow& window) : window(window) {}
+
+    RasterGrid outputGrid(const RasterGrid& input) const override
+    {
+        RasterGrid grid = input;
+        grid.xSize = window.width;
+        grid.ySize = window.height;
+        double* gt = grid.geoTransform;
+        gt[0] += window.x * gt[1] + window.y * gt[2];
+        gt[3] += window.x * gt[4] + window.y * gt[5];
+        return grid;
+    }
+
+    BlockWindow inputWindow(const BlockWindow& output) override
+    {
+        return {output.x + window.x, output.y + window.y, output.width, output.height};
+    }
+
+    void run(BlockBuffer& buffer, const BlockWindow& output, const ComputeBackend&) override
+    {
+        buffer.window = output;
+    }
+
+private:
+    BlockWindow window;
+};
+
+// Reprojects windows of its input grid into a target CRS. The output grid is
+// computed once; each thread keeps its own cached approximate transformer
+// (output pixel to source pixel) because GDAL transformers are not safe to
+// share
+class WarpStage : public BlockStage
+{
+public:
+    static std::unique_ptr<WarpStage> create(const RasterGrid& input, const QString& targetSrs, double resolution, ResamplingMethod resampling, QString& error)
+    {
+        OGRSpatialReference srs;
+        if (srs.SetFromUserInput(targetSrs.toStdString().c_str()) != OGRERR_NONE)
+        {
+            error = "Invalid target CRS: " + targetSrs;
+            return nullptr;
+        }
+
+        std::unique_ptr<WarpStage> stage(new WarpStage());
+        char* pszWkt = nullptr;
+        srs.exportToWkt(&pszWkt);
+        stage->dstWkt = pszWkt ? pszWkt : "";
+        CPLFree(pszWkt);
+
+        if (!input.hasGeoTransform || input.projection.empty())
+        {
+            error = "Reprojection needs an input with a geotransform and a CRS.";
+            return nullptr;
+        }
+        std::copy(input.geoTransform, input.geoTransform + 6, stage->srcGeoTransform);
+        stage->srcWkt = input.projection;
+        stage->srcXSize = input.xSize;
+        stage->srcYSize = input.ySize;
+        stage->resampling = resampling;
+        stage->noData = input.bandNoData;
+
+        // GDAL suggests the output from a dataset, so describe the input grid
+        // (which may be a subset of the file) with a band-less MEM dataset
+        GDALDriver* poMemDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+        GDALDataset* poProxy = poMemDriver ? poMemDriver->Create("", input.xSize, input.ySize, 0, GDT_Byte, nullptr) : nullptr;
+        if (!poProxy)
+        {
+            error = "Reprojection needs GDAL's MEM driver.";
+            return nullptr;
+        }
+        poProxy->SetGeoTransform(stage->srcGeoTransform);
+        poProxy->SetProjection(stage->srcWkt.c_str());
+
+        // Let GDAL suggest the output extent and resolution
+        char** papszTO = CSLSetNameValue(nullptr, "DST_SRS", stage->dstWkt.c_str());
+        void* hTransformArg = GDALCreateGenImgProjTransformer2(poProxy, nullptr, papszTO);
+        CSLDestroy(papszTO);
+        if (!hTransformArg)
+        {
+            GDALClose(poProxy);
+            error = "Cannot transform to " + targetSrs + ".\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+            return nullptr;
+        }
+
+        double extent[4];
+        CPLErr err = GDALSuggestedWarpOutput2(poProxy, GDALGenImgProjTransform, hTransformArg,
+                                              stage->dstGeoTransform, &stage->dstXSize, &stage->dstYSize, extent, 0);
+        GDALDestroyGenImgProjTransformer(hTransformArg);
+        GDALClose(poProxy);
+        if (err != CE_None)
+        {
+            error = "Failed to compute the reprojected extent.\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+            return nullptr;
+        }
+
+        // A requested resolution keeps the suggested extent
+        if (resolution > 0.0)
+        {
+            double minX = extent[0];
+            double minY = extent[1];
+            double maxX = extent[2];
+            double maxY = extent[3];
+            stage->dstXSize = std::max(1, static_cast<int>(std::ceil((maxX - minX) / resolution - 1e-6)));
+            stage->dstYSize = std::max(1, static_cast<int>(std::ceil((maxY - minY) / resolution - 1e-6)));
+            double geoTransform[6] = {minX, resolution, 0.0, maxY, 0.0, -resolution};
+            std::copy(geoTransform, geoTransform + 6, stage->dstGeoTransform);
+        }
+
+        return stage;
+    }
+
+    // Snaps the output grid outward to multiples of step from (originX, originY),
+    // clipped to bounds (minx, miny, maxx, maxy); used to match a tile matrix
+    void alignTo(double originX, double originY, double step, const double bounds[4])
+    {
+        double res = dstGeoTransform[1];
+        double minX = std::max(bounds[0], dstGeoTransform[0]);
+        double maxX = std::min(bounds[2], dstGeoTransform[0] + dstXSize * res);
+        double maxY = std::min(bounds[3], dstGeoTransform[3]);
+        double minY = std::max(bounds[1], dstGeoTransform[3] + dstYSize * dstGeoTransform[5]);
+
+        minX = originX + std::floor((minX - originX) / step + 1e-9) * step;
+        maxX = originX + std::ceil((maxX - originX) / step - 1e-9) * step;
+        maxY = originY - std::floor((originY - maxY) / step + 1e-9) * step;
+        minY = originY - std::ceil((originY - minY) / step - 1e-9) * step;
+
+        dstXSize = std::max(1, static_cast<int>(std::lround((maxX - minX) / res)));
+        dstYSize = std::max(1, static_cast<int>(std::lround((maxY - minY) / res)));
+        double geoTransform[6] = {minX, res, 0.0, maxY, 0.0, -res};
+        std::copy(geoTransform, geoTransform + 6, dstGeoTransform);
+    }
+
+    ~WarpStage() override
+    {
+        for (auto it = transformers.begin(); it != transformers.end(); ++it)
+        {
+            if (it.value())
+                GDALDestroyApproxTransformer(it.value());
+        }
+    }
+
+    RasterGrid outputGrid(const RasterGrid& input) const override
+    {
+        RasterGrid grid = input;
+        grid.xSize = dstXSize;
+        grid.ySize = dstYSize;
+        grid.hasGeoTransform = true;
+        std::copy(dstGeoTransform, dstGeoTransform + 6, grid.geoTransform);
+        grid.projection = dstWkt;
+        return grid;
+    }
+
+    BlockWindow inputWindow(const BlockWindow& output) override
+    {
+        void* hTransform = threadTransformer();
+        if (!hTransform)
+            return {};
+
+        // Sample a grid over the window; the halo below absorbs curvature between samples
+        const int nSteps = 32;
+        std::vector<double> xs;
+        std::vector<double> ys;
+        for (int j = 0; j <= nSteps; ++j)
+        {
+            for (int i = 0; i <= nSteps; ++i)
+            {
+                xs.push_back(output.x + output.width * static_cast<double>(i) / nSteps);
+                ys.push_back(output.y + output.height * static_cast<double>(j) / nSteps);
+            }
+        }
+        std::vector<double> zs(xs.size(), 0.0);
+        std::vector<int> success(xs.size(), FALSE);
+        GDALApproxTransform(hTransform, TRUE, static_cast<int>(xs.size()), xs.data(), ys.data(), zs.data(), success.data());
+
+        double minX = std::numeric_limits<double>::max();
+        double minY = std::numeric_limits<double>::max();
+        double maxX = std::numeric_limits<double>::lowest();
+        double maxY = std::numeric_limits<double>::lowest();
+        for (size_t i = 0; i < xs.size(); ++i)
+        {
+            if (!success[i])
+                continue;
+            minX = std::min(minX, xs[i]);
+            maxX = std::max(maxX, xs[i]);
+            minY = std::min(minY, ys[i]);
+            maxY = std::max(maxY, ys[i]);
+        }
+        if (minX > maxX)
+            return {};
+
+        int halo = resampling == ResamplingMethod::Nearest ? 1 : 2;
+        int x0 = std::max(0, static_cast<int>(std::floor(minX)) - halo);
+        int y0 = std::max(0, static_cast<int>(std::floor(minY)) - halo);
+        int x1 = std::min(srcXSize, static_cast<int>(std::ceil(maxX)) + halo);
+        int y1 = std::min(srcYSize, static_cast<int>(std::ceil(maxY)) + halo);
+        if (x1 <= x0 || y1 <= y0)
+            return {};
+
+        return {x0, y0, x1 - x0, y1 - y0};
+    }
+
+    void run(BlockBuffer& buffer, const BlockWindow& output, const ComputeBackend&) override
+    {
+        const BlockWindow src = buffer.window;
+        int nBands = buffer.bandCount();
+
+        // Source pixels as doubles so every data type samples the same way
+        std::vector<std::vector<double>> srcValues(nBands);
+        std::vector<double> fill(nBands, 0.0);
+        for (int b = 0; b < nBands; ++b)
+        {
+            fill[b] = noData[b].value_or(0.0);
+            if (src.width <= 0)
+                continue;
+
+            BandView view = buffer.band(b);
+            srcValues[b].resize(static_cast<size_t>(src.width) * src.height);
+            for (int row = 0; row < src.height; ++row)
+            {
+                GDALCopyWords(view.data + row * view.lineSpace, buffer.bandTypes[b], static_cast<int>(view.pixelSpace),
+                              srcValues[b].data() + static_cast<size_t>(row) * src.width, GDT_Float64, sizeof(double), src.width);
+            }
+        }
+
+        std::vector<std::vector<char>> outData(nBands);
+        for (int b = 0; b < nBands; ++b)
+        {
+            outData[b].resize(static_cast<size_t>(GDALGetDataTypeSizeBytes(buffer.bandTypes[b])) * output.width * output.height);
+        }
+
+        void* hTransform = src.width > 0 ? threadTransformer() : nullptr;
+        std::vector<double> xs(output.width);
+        std::vector<double> ys(output.width);
+        std::vector<double> zs(output.width);
+        std::vector<int> success(output.width);
+        std::vector<double> row(output.width);
+
+        for (int j = 0; j < output.height; ++j)
+        {
+            for (int i = 0; i < output.width; ++i)
+            {
+                xs[i] = output.x + i + 0.5;
+                ys[i] = output.y + j + 0.5;
+                zs[i] = 0.0;
+                success[i] = FALSE;
+            }
+            if (hTransform)
+            {
+                GDALApproxTransform(hTransform, TRUE, output.width, xs.data(), ys.data(), zs.data(), success.data());
+            }
+
+            for (int b = 0; b < nBands; ++b)
+            {
+                for (int i = 0; i < output.width; ++i)
+                {
+                    row[i] = success[i] ? sample(srcValues[b], src, xs[i], ys[i], noData[b], fill[b]) : fill[b];
+                }
+
+                int nTypeSize = GDALGetDataTypeSizeBytes(buffer.bandTypes[b]);
+                GDALCopyWords(row.data(), GDT_Float64, sizeof(double),
+                              outData[b].data() + static_cast<size_t>(j) * output.width * nTypeSize, buffer.bandTypes[b], nTypeSize, output.width);
+            }
+        }
+
+        buffer.bandData = std::move(outData);
+        buffer.mappedBands.clear();
+        buffer.window = output;
+    }
+
+private:
+    WarpStage() = default;
+
+    // Samples source pixel coordinates (sx, sy) from the window read for this block
+    double sample(const std::vector<double>& values, const BlockWindow& src, double sx, double sy,
+                  const std::optional<double>& noData, double fill) const
+    {
+        if (sx < 0.0 || sy < 0.0 || sx >= srcXSize || sy >= srcYSize)
+            return fill;
+
+        int ix = static_cast<int>(std::floor(sx)) - src.x;
+        int iy = static_cast<int>(std::floor(sy)) - src.y;
+        if (ix < 0 || iy < 0 || ix >= src.width || iy >= src.height)
+            return fill;
+
+        double nearest = values[static_cast<size_t>(iy) * src.width + ix];
+        if (resampling == ResamplingMethod::Nearest)
+            return nearest;
+
+        // Bilinear between the four surrounding pixel centres, clamped to the window
+        double fx = sx - 0.5 - src.x;
+        double fy = sy - 0.5 - src.y;
+        int x0 = std::clamp(static_cast<int>(std::floor(fx)), 0, src.width - 1);
+        int y0 = std::clamp(static_cast<int>(std::floor(fy)), 0, src.height - 1);
+        int x1 = std::min(x0 + 1, src.width - 1);
+        int y1 = std::min(y0 + 1, src.height - 1);
+        double ax = std::clamp(fx - x0, 0.0, 1.0);
+        double ay = std::clamp(fy - y0, 0.0, 1.0);
+
+        double v00 = values[static_cast<size_t>(y0) * src.width + x0];
+        double v10 = values[static_cast<size_t>(y0) * src.width + x1];
+        double v01 = values[static_cast<size_t>(y1) * src.width + x0];
+        double v11 = values[static_cast<size_t>(y1) * src.width + x1];
+
+        // Do not blend nodata into valid pixels
+        if (noData && (v00 == *noData || v10 == *noData || v01 == *noData || v11 == *noData))
+            return nearest;
+
+        double top = v00 + (v10 - v00) * ax;
+        double bottom = v01 + (v11 - v01) * ax;
+        return top + (bottom - top) * ay;
+    }
+
+    void* threadTransformer()
+    {
+        QMutexLocker locker(&transformerMutex);
+        void*& hTransform = transformers[QThread::currentThread()];
+        if (!hTransform)
+        {
+            void* hGenImgProj = GDALCreateGenImgProjTransformer3(srcWkt.c_str(), srcGeoTransform, dstWkt.c_str(), dstGeoTransform);
+            if (hGenImgProj)
+            {
+                // Exact transforms only every few pixels, linear in between
+                hTransform = GDALCreateApproxTransformer(GDALGenImgProjTransform, hGenImgProj, 0.125);
+                GDALApproxTransformerOwnsSubtransformer(hTransform, TRUE);
+            }
+        }
+        return hTransform;
+    }
+
+    std::string srcWkt;
+    std::string dstWkt;
+    double srcGeoTransform[6] = {};
+    double dstGeoTransform[6] = {};
+    int srcXSize = 0;
+    int srcYSize = 0;
+    int dstXSize = 0;
+    int dstYSize = 0;
+    ResamplingMethod resampling = ResamplingMethod::Nearest;
+    std::vector<std::optional<double>> noData;
+
+    QMutex transformerMutex;
+    QMap<QThread*, void*> transformers;
+};
+
+// Scales the grid to a new pixel size with a separable kernel. The vertical
+// pass runs first so both passes sum whole rows with the backend's
+// weightedSum: the vertical pass sums input rows, and the horizontal pass
+// works on the transposed block so its taps become rows too
+class ResizeStage : public BlockStage
+{
+public:
+    ResizeStage(const RasterGrid& input, int width, int height, ResamplingMethod resampling)
+        : inXSize(input.xSize), inYSize(input.ySize), outXSize(width), outYSize(height), resampling(resampling)
+    {
+        columnTaps = buildTaps(inXSize, outXSize);
+        rowTaps = buildTaps(inYSize, outYSize);
+        noData = input.bandNoData;
+    }
+
+    RasterGrid outputGrid(const RasterGrid& input) const override
+    {
+        RasterGrid grid = input;
+        grid.xSize = outXSize;
+        grid.ySize = outYSize;
+        double scaleX = static_cast<double>(inXSize) / outXSize;
+        double scaleY = static_cast<double>(inYSize) / outYSize;
+        grid.geoTransform[1] *= scaleX;
+        grid.geoTransform[4] *= scaleX;
+        grid.geoTransform[2] *= scaleY;
+        grid.geoTransform[5] *= scaleY;
+        return grid;
+    }
+
+    // The union of the kernel footprints is the window plus its halo
+    BlockWindow inputWindow(const BlockWindow& output) override
+    {
+        if (output.width <= 0 || output.height <= 0)
+            return {};
+
+        int x0 = columnTaps[output.x].first;
+        int x1 = columnTaps[output.x].last;
+        int y0 = rowTaps[output.y].first;
+        int y1 = rowTaps[output.y].last;
+        for (int i = output.x; i < output.x + output.width; ++i)
+        {
+            x0 = std::min(x0, columnTaps[i].first);
+            x1 = std::max(x1, columnTaps[i].last);
+        }
+        for (int j = output.y; j < output.y + output.height; ++j)
+        {
+            y0 = std::min(y0, rowTaps[j].first);
+            y1 = std::max(y1, rowTaps[j].last);
+        }
+        return {x0, y0, x1 - x0 + 1, y1 - y0 + 1};
+    }
+
+    void run(BlockBuffer& buffer, const BlockWindow& output, const ComputeBackend& backend) override
+    {
+        const BlockWindow src = buffer.window;
+        int nBands = buffer.bandCount();
+        std::vector<std::vector<char>> outData(nBands);
+
+        for (int b = 0; b < nBands; ++b)
+        {
+            int nTypeSize = GDALGetDataTypeSizeBytes(buffer.bandTypes[b]);
+            outData[b].resize(static_cast<size_t>(nTypeSize) * output.width * output.height);
+            if (src.width <= 0)
+                continue;
+
+            if (resampling == ResamplingMethod::Nearest)
+                resizeNearest(buffer.band(b), nTypeSize, src, output, outData[b].data());
+            else
+                resizeKernel(buffer.band(b), buffer.bandTypes[b], noData[b], src, output, backend, outData[b].data());
+        }
+
+        buffer.bandData = std::move(outData);
+        buffer.mappedBands.clear();
+        buffer.window = output;
+    }
+
+private:
+    // Contributing input pixels [first, last] of one output pixel, and their
+    // weights (normalised to sum to one) in input order, in single and
+    // double precision
+    struct Taps
+    {
+        int first = 0;
+        int last = 0;
+        std::vector<float> weights;
+        std::vector<double> preciseWeights;
+    };
+
+    static double kernel(ResamplingMethod method, double x)
+    {
+        x = std::fabs(x);
+        switch (method)
+        {
+        case ResamplingMethod::Bilinear:
+            return x < 1.0 ? 1.0 - x : 0.0;
+        case ResamplingMethod::Cubic:
+        {
+            // Catmull-Rom (a = -0.5), as used by GDAL's cubic
+            const double a = -0.5;
+            if (x < 1.0)
+                return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+            if (x < 2.0)
+                return ((a * x - 5.0 * a) * x + 8.0 * a) * x - 4.0 * a;
+            return 0.0;
+        }
+        case ResamplingMethod::Lanczos:
+        {
+            if (x < 1e-12)
+                return 1.0;
+            if (x >= 3.0)
+                return 0.0;
+            const double pi = 3.14159265358979323846;
+            double px = pi * x;
+            return 3.0 * std::sin(px) * std::sin(px / 3.0) / (px * px);
+        }
+        default:
+            return 0.0;
+        }
+    }
+
+    static double kernelRadius(ResamplingMethod method)
+    {
+        switch (method)
+        {
+        case ResamplingMethod::Bilinear: return 1.0;
+        case ResamplingMethod::Cubic: return 2.0;
+        case ResamplingMethod::Lanczos: return 3.0;
+        default: return 0.5;
+        }
+    }
+
+    std::vector<Taps> buildTaps(int inSize, int outSize) const
+    {
+        std::vector<Taps> taps(outSize);
+        double scale = static_cast<double>(inSize) / outSize;
+
+        // Downsampling widens the kernel so every input pixel contributes
+        double support = std::max(1.0, scale);
+        double radius = kernelRadius(resampling) * support;
+
+        for (int i = 0; i < outSize; ++i)
+        {
+            double centre = (i + 0.5) * scale;
+            Taps& t = taps[i];
+
+            if (resampling == ResamplingMethod::Nearest)
+            {
+                t.first = t.last = std::clamp(static_cast<int>(std::floor(centre)), 0, inSize - 1);
+                t.weights.assign(1, 1.0f);
+                t.preciseWeights.assign(1, 1.0);
+                continue;
+            }
+
+            int first = static_cast<int>(std::floor(centre - radius));
+            int last = static_cast<int>(std::ceil(centre + radius)) - 1;
+            std::vector<double> weights;
+            double total = 0.0;
+            for (int j = first; j <= last; ++j)
+            {
+                double w;
+                if (resampling == ResamplingMethod::Average)
+                {
+                    // Fraction of the input pixel covered by the output pixel's footprint
+                    double lo = std::max<double>(j, centre - radius);
+                    double hi = std::min<double>(j + 1, centre + radius);
+                    w = std::max(0.0, hi - lo);
+                }
+                else
+                {
+                    w = kernel(resampling, (j + 0.5 - centre) / support);
+                }
+                weights.push_back(w);
+                total += w;
+            }
+
+            // Edge pixels are repeated past the border: fold those taps onto the edge
+            t.first = std::clamp(first, 0, inSize - 1);
+            t.last = std::clamp(last, 0, inSize - 1);
+            t.weights.assign(t.last - t.first + 1, 0.0f);
+            t.preciseWeights.assign(t.weights.size(), 0.0);
+            std::vector<double> folded(t.weights.size(), 0.0);
+            for (int j = first; j <= last; ++j)
+                folded[std::clamp(j, 0, inSize - 1) - t.first] += weights[j - first];
+            for (size_t k = 0; k < folded.size(); ++k)
+            {
+                t.preciseWeights[k] = total != 0.0 ? folded[k] / total : 0.0;
+                t.weights[k] = static_cast<float>(t.preciseWeights[k]);
+            }
+        }
+        return taps;
+    }
+
+    // Nearest picks whole pixels, so it copies bytes and keeps every value exact
+    void resizeNearest(const BandView& view, int nTypeSize, const BlockWindow& src, const BlockWindow& output, char* out) const
+    {
+        for (int j = 0; j < output.height; ++j)
+        {
+            const char* srcRow = view.data + (rowTaps[output.y + j].first - src.y) * view.lineSpace;
+            char* dstRow = out + static_cast<size_t>(j) * output.width * nTypeSize;
+            for (int i = 0; i < output.width; ++i)
+            {
+                memcpy(dstRow + static_cast<size_t>(i) * nTypeSize,
+                       srcRow + (columnTaps[output.x + i].first - src.x) * view.pixelSpace, nTypeSize);
+            }
+        }
+    }
+
+    // Float32 fits every other type exactly (up to 24-bit integers); Float64
+    // and 32-bit integers keep their precision only in double
+    void resizeKernel(const BandView& view, GDALDataType eType, const std::optional<double>& bandNoData,
+                      const BlockWindow& src, const BlockWindow& output, const ComputeBackend& backend, char* out) const
+    {
+        if (eType != GDT_Float32 && GDALGetDataTypeSizeBits(eType) >= 32)
+            resizeKernelAs<double>(view, eType, bandNoData, src, output, backend, out);
+        else
+            resizeKernelAs<float>(view, eType, bandNoData, src, output, backend, out);
+    }
+
+    // Vertical then horizontal pass in T. With nodata, values and a validity
+    // mask are resampled together and the result renormalised, so nodata is
+    // never blended into valid pixels
+    template <typename T>
+    void resizeKernelAs(const BandView& view, GDALDataType eType, const std::optional<double>& bandNoData,
+                        const BlockWindow& src, const BlockWindow& output, const ComputeBackend& backend, char* out) const
+    {
+        const GDALDataType eWorkType = std::is_same_v<T, double> ? GDT_Float64 : GDT_Float32;
+        size_t srcPixels = static_cast<size_t>(src.width) * src.height;
+        std::vector<T> values(srcPixels);
+        for (int row = 0; row < src.height; ++row)
+        {
+            GDALCopyWords(view.data + row * view.lineSpace, eType, static_cast<int>(view.pixelSpace),
+                          values.data() + static_cast<size_t>(row) * src.width, eWorkType, sizeof(T), src.width);
+        }
+
+        std::vector<T> mask;
+        if (bandNoData)
+        {
+            T noDataValue = static_cast<T>(*bandNoData);
+            mask.assign(srcPixels, T(1));
+            for (size_t i = 0; i < srcPixels; ++i)
+            {
+                if (values[i] == noDataValue || std::isnan(values[i]))
+                {
+                    values[i] = T(0);
+                    mask[i] = T(0);
+                }
+            }
+        }
+
+        std::vector<T> result = resample(values, src, output, backend);
+        if (bandNoData)
+        {
+            std::vector<T> coverage = resample(mask, src, output, backend);
+            if constexpr (std::is_same_v<T, float>)
+            {
+                backend.binary(ComputeBackend::Divide, result.data(), coverage.data(), result.data(), result.size());
+            }
+            else
+            {
+                for (size_t i = 0; i < result.size(); ++i)
+                    result[i] /= coverage[i];
+            }
+
+            // Mostly-nodata footprints stay nodata
+            T noDataValue = static_cast<T>(*bandNoData);
+            for (size_t i = 0; i < result.size(); ++i)
+            {
+                if (coverage[i] < T(0.5))
+                    result[i] = noDataValue;
+            }
+        }
+
+        int nTypeSize = GDALGetDataTypeSizeBytes(eType);
+        GDALCopyWords(result.data(), eWorkType, sizeof(T), out, eType, nTypeSize,
+                      static_cast<int>(result.size()));
+    }
+
+    // Weighted sum of rows; float goes through the backend's kernels, double
+    // is summed here with the double-precision weights
+    static void sumRows(const ComputeBackend& backend, const float* const* rows, const Taps& t, float* out, size_t n)
+    {
+        backend.weightedSum(rows, t.weights.data(), static_cast<int>(t.weights.size()), out, n);
+    }
+
+    static void sumRows(const ComputeBackend&, const double* const* rows, const Taps& t, double* out, size_t n)
+    {
+        std::fill(out, out + n, 0.0);
+        for (size_t k = 0; k < t.preciseWeights.size(); ++k)
+        {
+            const double w = t.preciseWeights[k];
+            const double* row = rows[k];
+            for (size_t i = 0; i < n; ++i)
+                out[i] += w * row[i];
+        }
+    }
+
+    // Returns output.height x output.width samples from a src-sized block
+    template <typename T>
+    std::vector<T> resample(const std::vector<T>& values, const BlockWindow& src, const BlockWindow& output,
+                            const ComputeBackend& backend) const
+    {
+        // Vertical pass: each output row is a weighted sum of input rows
+        std::vector<T> vertical(static_cast<size_t>(output.height) * src.width);
+        std::vector<const T*> rows;
+        for (int j = 0; j < output.height; ++j)
+        {
+            const Taps& t = rowTaps[output.y + j];
+            rows.clear();
+            for (int k = t.first; k <= t.last; ++k)
+                rows.push_back(values.data() + static_cast<size_t>(k - src.y) * src.width);
+            sumRows(backend, rows.data(), t, vertical.data() + static_cast<size_t>(j) * src.width, src.width);
+        }
+
+        // Horizontal pass on the transpose: input columns become contiguous rows
+        std::vector<T> transposed(vertical.size());
+        for (int j = 0; j < output.height; ++j)
+        {
+            for (int i = 0; i < src.width; ++i)
+                transposed[static_cast<size_t>(i) * output.height + j] = vertical[static_cast<size_t>(j) * src.width + i];
+        }
+
+        std::vector<T> column(output.height);
+        std::vector<T> result(static_cast<size_t>(output.width) * output.height);
+        for (int i = 0; i < output.width; ++i)
+        {
+            const Taps& t = columnTaps[output.x + i];
+            rows.clear();
+            for (int k = t.first; k <= t.last; ++k)
+                rows.push_back(transposed.data() + static_cast<size_t>(k - src.x) * output.height);
+            sumRows(backend, rows.data(), t, column.data(), output.height);
+            for (int j = 0; j < output.height; ++j)
+                result[static_cast<size_t>(j) * output.width + i] = column[j];
+        }
+        return result;
+    }
+
+    int inXSize;
+    int inYSize;
+    int outXSize;
+    int outYSize;
+    ResamplingMethod resampling;
+    std::vector<Taps> columnTaps;
+    std::vector<Taps> rowTaps;
+    std::vector<std::optional<double>> noData;
+};
+
+// Band-math expressions such as "(B4-B3)/(B4+B3)", one output band per
+// ';'-separated expression. Each expression is parsed once per job into a
+// register program of backend binary ops. The program runs over
+// cache-sized chunks of a window, so intermediates stay in cache and each
+// op is one vector loop instead of a per-pixel interpretation
+class BandMathStage : public BlockStage
+{
+public:
+    static std::unique_ptr<BandMathStage> create(const RasterGrid& input, const QString& expressions, QString& error)
+    {
+        std::unique_ptr<BandMathStage> stage(new BandMathStage());
+        stage->inputBandCount = static_cast<int>(input.bandTypes.size());
+
+        const QStringList parts = expressions.split(';', Qt::SkipEmptyParts);
+        for (const QString& part : parts)
+        {
+            Parser parser{part.toStdString(), 0, *stage, {}};
+            Operand result = parser.parseExpression();
+            parser.skipSpaces();
+            if (parser.error.empty() && parser.pos < parser.text.size())
+                parser.error = "unexpected '" + std::string(1, parser.text[parser.pos]) + "'";
+            if (!parser.error.empty())
+            {
+                error = QString("Invalid band math expression \"%1\": %2").arg(part.trimmed(), QString::fromStdString(parser.error));
+                return nullptr;
+            }
+            stage->outputs.push_back(result);
+        }
+
+        if (stage->outputs.empty())
+        {
+            error = "The band math expression is empty.";
+            return nullptr;
+        }
+
+        // A pixel is nodata when any band it reads is nodata
+        for (int band : stage->usedBands)
+        {
+            if (input.bandNoData[band])
+                stage->bandNoData.push_back({band, static_cast<float>(*input.bandNoData[band])});
+        }
+        return stage;
+    }
+
+    RasterGrid outputGrid(const RasterGrid& input) const override
+    {
+        RasterGrid grid = input;
+        grid.bandTypes.assign(outputs.size(), GDT_Float32);
+        std::optional<double> noData;
+        if (!bandNoData.empty())
+            noData = std::numeric_limits<double>::quiet_NaN();
+        grid.bandNoData.assign(outputs.size(), noData);
+        return grid;
+    }
+
+    void run(BlockBuffer& buffer, const BlockWindow& output, const ComputeBackend& backend) override
+    {
+        size_t nPixels = static_cast<size_t>(output.width) * output.height;
+
+        // Only the bands the expressions reference are converted
+        std::vector<std::vector<float>> bands(inputBandCount);
+        for (int band : usedBands)
+        {
+            bands[band].resize(nPixels);
+            BandView view = buffer.band(band);
+            for (int row = 0; row < output.height; ++row)
+            {
+                GDALCopyWords(view.data + row * view.lineSpace, buffer.bandTypes[band], static_cast<int>(view.pixelSpace),
+                              bands[band].data() + static_cast<size_t>(row) * output.width, GDT_Float32, sizeof(float), output.width);
+            }
+        }
+
+        std::vector<std::vector<char>> outData(outputs.size(), std::vector<char>(nPixels * sizeof(float)));
+        std::vector<float> registers(static_cast<size_t>(registerCount) * ChunkSize);
+        std::vector<float> constantValues(static_cast<size_t>(constants.size()) * ChunkSize);
+        for (size_t c = 0; c < constants.size(); ++c)
+            std::fill_n(constantValues.begin() + c * ChunkSize, ChunkSize, constants[c]);
+
+        for (size_t offset = 0; offset < nPixels; offset += ChunkSize)
+        {
+            size_t n = std::min<size_t>(ChunkSize, nPixels - offset);
+            auto resolve = [&](const Operand& operand) -> float* {
+                switch (operand.kind)
+                {
+                case Operand::Band: return bands[operand.index].data() + offset;
+                case Operand::Constant: return constantValues.data() + static_cast<size_t>(operand.index) * ChunkSize;
+                default: return registers.data() + static_cast<size_t>(operand.index) * ChunkSize;
+                }
+            };
+
+            for (const Instruction& instruction : program)
+            {
+                backend.binary(instruction.op, resolve(instruction.a), resolve(instruction.b),
+                               registers.data() + static_cast<size_t>(instruction.target) * ChunkSize, n);
+            }
+
+            for (size_t o = 0; o < outputs.size(); ++o)
+            {
+                float* out = reinterpret_cast<float*>(outData[o].data()) + offset;
+                std::copy_n(resolve(outputs[o]), n, out);
+            }
+        }
+
+        for (const auto& [band, value] : bandNoData)
+        {
+            const std::vector<float>& values = bands[band];
+            for (size_t i = 0; i < nPixels; ++i)
+            {
+                if (values[i] != value && !std::isnan(values[i]))
+                    continue;
+                for (std::vector<char>& data : outData)
+                    reinterpret_cast<float*>(data.data())[i] = std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+
+        buffer.bandData = std::move(outData);
+        buffer.bandTypes.assign(outputs.size(), GDT_Float32);
+        buffer.mappedBands.clear();
+        buffer.window = output;
+    }
+
+private:
+    static constexpr size_t ChunkSize = 2048;
+
+    struct Operand
+    {
+        enum Kind { Band, Constant, Register };
+        Kind kind = Constant;
+        int index = 0;
+    };
+
+    struct Instruction
+    {
+        ComputeBackend::BinaryOp op;
+        Operand a;
+        Operand b;
+        int target;
+    };
+
+    // Recursive descent over: expr = term {(+|-) term}; term = unary {(*|/) unary};
+    // unary = [-] primary; primary = number | B<n> | min(expr, expr) | max(expr, expr) | (expr)
+    struct Parser
+    {
+        std::string text;
+        size_t pos;
+        BandMathStage& stage;
+        std::string error;
+
+        void skipSpaces()
+        {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+                ++pos;
+        }
+
+        bool accept(char c)
+        {
+            skipSpaces();
+            if (pos < text.size() && text[pos] == c)
+            {
+                ++pos;
+                return true;
+            }
+            return false;
+        }
+
+        // Operands are meaningless once an error is set, so nothing is emitted
+        Operand push(ComputeBackend::BinaryOp op, const Operand& a, const Operand& b)
+        {
+            return error.empty() ? stage.push(op, a, b) : Operand{};
+        }
+
+        Operand parseExpression()
+        {
+            Operand left = parseTerm();
+            while (error.empty())
+            {
+                if (accept('+'))
+                    left = push(ComputeBackend::Add, left, parseTerm());
+                else if (accept('-'))
+                    left = push(ComputeBackend::Subtract, left, parseTerm());
+                else
+                    break;
+            }
+            return left;
+        }
+
+        Operand parseTerm()
+        {
+            Operand left = parseUnary();
+            while (error.empty())
+            {
+                if (accept('*'))
+                    left = push(ComputeBackend::Multiply, left, parseUnary());
+                else if (accept('/'))
+                    left = push(ComputeBackend::Divide, left, parseUnary());
+                else
+                    break;
+            }
+            return left;
+        }
+
+        Operand parseUnary()
+        {
+            if (accept('-'))
+                return push(ComputeBackend::Subtract, stage.constant(0.0f), parseUnary());
+            accept('+');
+            return parsePrimary();
+        }
+
+        Operand parsePrimary()
+        {
+            skipSpaces();
+            if (pos >= text.size())
+            {
+                error = "unexpected end of expression";
+                return {};
+            }
+
+            if (accept('('))
+            {
+                Operand inner = parseExpression();
+                if (error.empty() && !accept(')'))
+                    error = "missing ')'";
+                return inner;
+            }
+
+            char c = text[pos];
+            if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+            {
+                const char* begin = text.c_str() + pos;
+                char* end = nullptr;
+                double value = std::strtod(begin, &end);
+                pos += end - begin;
+                return stage.constant(static_cast<float>(value));
+            }
+
+            size_t start = pos;
+            while (pos < text.size() && std::isalnum(static_cast<unsigned char>(text[pos])))
+                ++pos;
+            std::string word = text.substr(start, pos - start);
+
+            if (word == "min" || word == "max")
+            {
+                if (!accept('('))
+                {
+                    error = "expected '(' after " + word;
+                    return {};
+                }
+                Operand a = parseExpression();
+                if (!error.empty())
+                    return {};
+                if (!accept(','))
+                {
+                    error = "expected ',' in " + word;
+                    return {};
+                }
+                Operand b = parseExpression();
+                if (!error.empty())
+                    return {};
+                if (!accept(')'))
+                {
+                    error = "missing ')'";
+                    return {};
+                }
+                return push(word == "min" ? ComputeBackend::Minimum : ComputeBackend::Maximum, a, b);
+            }
+
+            if (word.size() > 1 && (word[0] == 'B' || word[0] == 'b') &&
+                std::all_of(word.begin() + 1, word.end(), [](char d) { return std::isdigit(static_cast<unsigned char>(d)); }))
+            {
+                int band = std::atoi(word.c_str() + 1);
+                if (band < 1 || band > stage.inputBandCount)
+                {
+                    error = "band " + word + " does not exist (the input has " + std::to_string(stage.inputBandCount) + " bands)";
+                    return {};
+                }
+                if (std::find(stage.usedBands.begin(), stage.usedBands.end(), band - 1) == stage.usedBands.end())
+                    stage.usedBands.push_back(band - 1);
+                return {Operand::Band, band - 1};
+            }
+
+            error = word.empty() ? "unexpected '" + std::string(1, c) + "'" : "unknown name '" + word + "'";
+            return {};
+        }
+    };
+
+    BandMathStage() = default;
+
+    Operand constant(float value)
+    {
+        constants.push_back(value);
+        return {Operand::Constant, static_cast<int>(constants.size()) - 1};
+    }
+
+    // Constant subexpressions are folded with the reference kernel
+    Operand push(ComputeBackend::BinaryOp op, const Operand& a, const Operand& b)
+    {
+        Q_ASSERT(isValid(a) && isValid(b));
+        if (a.kind == Operand::Constant && b.kind == Operand::Constant)
+        {
+            float result = 0.0f;
+            ComputeBackend::scalar().binary(op, &constants[a.index], &constants[b.index], &result, 1);
+            return constant(result);
+        }
+
+        Operand target{Operand::Register, registerCount++};
+        program.push_back({op, a, b, target.index});
+        return target;
+    }
+
+    bool isValid(const Operand& operand) const
+    {
+        switch (operand.kind)
+        {
+        case Operand::Band: return operand.index >= 0 && operand.index < inputBandCount;
+        case Operand::Constant: return operand.index >= 0 && operand.index < static_cast<int>(constants.size());
+        default: return operand.index >= 0 && operand.index < registerCount;
+        }
+    }
+
+    int inputBandCount = 0;
+    std::vector<int> usedBands;
+    std::vector<float> constants;
+    std::vector<Instruction> program;
+    std::vector<Operand> outputs;
+    int registerCount = 0;
+    std::vector<std::pair<int, float>> bandNoData;
+};
+
+// Issues read-ahead hints for windows a configurable distance ahead of the
+// read stage: AdviseRead lets the driver batch its own I/O, and for local
+// GTiff files the tile/strip byte ranges are passed to the kernel as well
+class ReadAheadPrefetcher
+{
+public:
+    ReadAheadPrefetcher(GDALDataset* poDataset, const QString& path, const std::vector<int>& bands, int distance)
+        : poDataset(poDataset), bands(bands), distance(distance)
+    {
+#ifdef POSIX_FADV_WILLNEED
+        // Byte ranges are only known for GTiff, and only local files have a
+        // descriptor; platforms without posix_fadvise (e.g. macOS) skip them
+        GDALDriver* poDriver = poDataset->GetDriver();
+        if (distance > 0 && poDriver && EQUAL(poDriver->GetDescription(), "GTiff") && !path.startsWith("/vsi"))
+        {
+            fd = open(path.toLocal8Bit().constData(), O_RDONLY);
+        }
+
+        const char* interleave = poDataset->GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE");
+        pixelInterleaved = interleave && EQUAL(interleave, "PIXEL");
+#endif
+    }
+
+    ~ReadAheadPrefetcher()
+    {
+#ifndef _WIN32
+        if (fd >= 0)
+            close(fd);
+#endif
+    }
+
+    ReadAheadPrefetcher(const ReadAheadPrefetcher&) = delete;
+    ReadAheadPrefetcher& operator=(const ReadAheadPrefetcher&) = delete;
+
+    // Hints every window in [from, from + distance) not hinted yet
+    void advise(const std::vector<BlockWindow>& windows, int from)
+    {
+        if (distance <= 0)
+            return;
+
+        int last = std::min(static_cast<int>(windows.size()), from + distance);
+        for (int i = std::max(from, nextWindow); i < last; ++i)
+        {
+            const BlockWindow& w = windows[i];
+            if (w.width <= 0 || w.height <= 0)
+                continue;
+
+            GDALDataType eType = poDataset->GetRasterBand(1)->GetRasterDataType();
+            poDataset->AdviseRead(w.x, w.y, w.width, w.height, w.width, w.height, eType,
+                                  static_cast<int>(bands.size()), bands.data(), nullptr);
+            adviseByteRanges(w);
+        }
+        nextWindow = std::max(nextWindow, last);
+    }
+
+private:
+    void adviseByteRanges(const BlockWindow& w)
+    {
+#ifdef POSIX_FADV_WILLNEED
+        if (fd < 0)
+            return;
+
+        // With pixel interleaving band 1 blocks hold every band
+        int nBands = pixelInterleaved ? 1 : static_cast<int>(bands.size());
+        for (int i = 0; i < nBands; ++i)
+        {
+            GDALRasterBand* poBand = poDataset->GetRasterBand(pixelInterleaved ? 1 : bands[i]);
+            int nBlockX = 0;
+            int nBlockY = 0;
+            poBand->GetBlockSize(&nBlockX, &nBlockY);
+            if (nBlockX <= 0 || nBlockY <= 0)
+                return;
+
+            for (int by = w.y / nBlockY; by <= (w.y + w.height - 1) / nBlockY; ++by)
+            {
+                for (int bx = w.x / nBlockX; bx <= (w.x + w.width - 1) / nBlockX; ++bx)
+                {
+                    const char* offset = poBand->GetMetadataItem(CPLSPrintf("BLOCK_OFFSET_%d_%d", bx, by), "TIFF");
+                    const char* size = poBand->GetMetadataItem(CPLSPrintf("BLOCK_SIZE_%d_%d", bx, by), "TIFF");
+                    if (!offset || !size)
+                        continue;
+
+                    // WILLNEED starts asynchronous readahead of the range
+                    posix_fadvise(fd, static_cast<off_t>(std::strtoll(offset, nullptr, 10)),
+                                  static_cast<off_t>(std::strtoll(size, nullptr, 10)), POSIX_FADV_WILLNEED);
+                }
+            }
+        }
+#else
+        (void)w;
+#endif
+    }
+
+    GDALDataset* poDataset;
+    std::vector<int> bands;
+    int distance;
+    int nextWindow = 0;
+    int fd = -1;
+    bool pixelInterleaved = false;
+};
+
+// Maps the selected input bands straight from the file when the driver can expose
+// it without a copy (uncompressed, native byte order raw/ENVI/GTiff layouts)
+class MappedInput
+{
+public:
+    static std::unique_ptr<MappedInput> create(GDALDataset* poDataset, const std::vector<int>& bandIndices)
+    {
+        if (!CPLIsVirtualMemFileMapAvailable())
+            return nullptr;
+
+        // Refuse GDAL's block-cache emulation: only a real file mapping avoids copies
+        char** papszOptions = CSLSetNameValue(nullptr, "USE_DEFAULT_IMPLEMENTATION", "NO");
+
+        std::unique_ptr<MappedInput> mapped(new MappedInput());
+        for (int bandIndex : bandIndices)
+        {
+            MappedBand band;
+            GIntBig nLineSpace = 0;
+            GDALRasterBand* poBand = poDataset->GetRasterBand(bandIndex);
+            band.eType = poBand->GetRasterDataType();
+            band.mem = poBand->GetVirtualMemAuto(GF_Read, &band.pixelSpace, &nLineSpace, papszOptions);
+            band.lineSpace = nLineSpace;
+            if (!band.mem)
+            {
+                CSLDestroy(papszOptions);
+                return nullptr;
+            }
+            band.base = static_cast<const char*>(CPLVirtualMemGetAddr(band.mem));
+            mapped->bands.push_back(band);
+        }
+
+        CSLDestroy(papszOptions);
+        return mapped;
+    }
+
+    ~MappedInput()
+    {
+        for (MappedBand& band : bands)
+            CPLVirtualMemFree(band.mem);
+    }
+
+    MappedInput(const MappedInput&) = delete;
+    MappedInput& operator=(const MappedInput&) = delete;
+
+    // Points the buffer at the mapped pixels of its window; nothing is copied
+    void view(BlockBuffer& buffer) const
+    {
+        const BlockWindow& w = buffer.window;
+        buffer.bandData.clear();
+        buffer.bandTypes.resize(bands.size());
+        buffer.mappedBands.resize(bands.size());
+        for (size_t b = 0; b < bands.size(); ++b)
+        {
+            const MappedBand& band = bands[b];
+            buffer.bandTypes[b] = band.eType;
+            buffer.mappedBands[b].data = band.base + w.y * band.lineSpace + static_cast<GSpacing>(w.x) * band.pixelSpace;
+            buffer.mappedBands[b].pixelSpace = band.pixelSpace;
+            buffer.mappedBands[b].lineSpace = band.lineSpace;
+        }
+    }
+
+private:
+    MappedInput() = default;
+
+    struct MappedBand
+    {
+        CPLVirtualMem* mem = nullptr;
+        GDALDataType eType = GDT_Unknown;
+        const char* base = nullptr;
+        int pixelSpace = 0;
+        GSpacing lineSpace = 0;
+    };
+
+    std::vector<MappedBand> bands;
+};
+
+#ifdef HAVE_IO_URING
+// Reads uncompressed GTiff tiles/strips straight from the file with io_uring,
+// keeping many block reads in flight instead of one synchronous read at a time
+class UringTileReader
+{
+public:
+    static constexpr unsigned queueDepth = 64;
+
+    // Only uncompressed, little-endian, byte-aligned local GTiff files are
+    // laid out simply enough to be assembled without libtiff
+    static bool supports(GDALDataset* poDataset, const QString& path)
+    {
+        GDALDriver* poDriver = poDataset->GetDriver();
+        if (!poDriver || !EQUAL(poDriver->GetDescription(), "GTiff") || path.startsWith("/vsi"))
+            return false;
+
+        const char* compression = poDataset->GetMetadataItem("COMPRESSION", "IMAGE_STRUCTURE");
+        if (compression && !EQUAL(compression, "NONE"))
+            return false;
+
+        if (std::endian::native != std::endian::little)
+            return false;
+
+        GDALDataType eType = poDataset->GetRasterBand(1)->GetRasterDataType();
+        for (int bandIndex = 1; bandIndex <= poDataset->GetRasterCount(); ++bandIndex)
+        {
+            GDALRasterBand* poBand = poDataset->GetRasterBand(bandIndex);
+            if (poBand->GetRasterDataType() != eType || poBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE") != nullptr)
+                return false;
+        }
+
+        // Big-endian files would need byte swapping
+        char header[2] = {0, 0};
+        VSILFILE* fp = VSIFOpenL(path.toLocal8Bit().constData(), "rb");
+        if (!fp)
+            return false;
+        size_t nRead = VSIFReadL(header, 1, 2, fp);
+        VSIFCloseL(fp);
+        return nRead == 2 && header[0] == 'I' && header[1] == 'I';
+    }
+
+    UringTileReader(GDALDataset* poDataset, const QString& path, const std::vector<int>& bands)
+        : poDataset(poDataset), bands(bands)
+    {
+        const char* interleave = poDataset->GetMetadataItem("INTERLEAVE", "IMAGE_STRUCTURE");
+        pixelInterleaved = interleave && EQUAL(interleave, "PIXEL") && poDataset->GetRasterCount() > 1;
+
+        fd = open(path.toLocal8Bit().constData(), O_RDONLY);
+        if (fd >= 0 && io_uring_queue_init(queueDepth, &ring, 0) == 0)
+        {
+            ringReady = true;
+        }
+    }
+
+    ~UringTileReader()
+    {
+        if (ringReady)
+            io_uring_queue_exit(&ring);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    UringTileReader(const UringTileReader&) = delete;
+    UringTileReader& operator=(const UringTileReader&) = delete;
+
+    bool isValid() const { return ringReady; }
+
+    bool read(BlockBuffer& buffer)
+    {
+        const BlockWindow& w = buffer.window;
+        int nBands = static_cast<int>(bands.size());
+        GDALDataType eType = poDataset->GetRasterBand(1)->GetRasterDataType();
+        int nTypeSize = GDALGetDataTypeSizeBytes(eType);
+
+        buffer.bandData.resize(nBands);
+        buffer.bandTypes.assign(nBands, eType);
+        for (int b = 0; b < nBands; ++b)
+        {
+            buffer.bandData[b].resize(static_cast<size_t>(nTypeSize) * w.width * w.height);
+        }
+
+        int nBlockX = 0;
+        int nBlockY = 0;
+        poDataset->GetRasterBand(1)->GetBlockSize(&nBlockX, &nBlockY);
+
+        // One request per block, per selected band unless the blocks are pixel
+        // interleaved; request.band is the buffer band, or 0 when interleaved
+        std::vector<BlockRequest> requests;
+        int nSourceBands = pixelInterleaved ? 1 : nBands;
+        for (int band = 0; band < nSourceBands; ++band)
+        {
+            GDALRasterBand* poBand = poDataset->GetRasterBand(pixelInterleaved ? 1 : bands[band]);
+            for (int by = w.y / nBlockY; by <= (w.y + w.height - 1) / nBlockY; ++by)
+            {
+                for (int bx = w.x / nBlockX; bx <= (w.x + w.width - 1) / nBlockX; ++bx)
+                {
+                    const char* offset = poBand->GetMetadataItem(CPLSPrintf("BLOCK_OFFSET_%d_%d", bx, by), "TIFF");
+                    const char* size = poBand->GetMetadataItem(CPLSPrintf("BLOCK_SIZE_%d_%d", bx, by), "TIFF");
+
+                    BlockRequest request;
+                    request.band = band;
+                    request.blockX = bx;
+                    request.blockY = by;
+                    request.offset = offset ? std::strtoull(offset, nullptr, 10) : 0;
+                    request.size = size ? std::strtoull(size, nullptr, 10) : 0;
+                    requests.push_back(std::move(request));
+                }
+            }
+        }
+
+        // Keep up to queueDepth reads in flight and assemble blocks as they complete
+        size_t nextRequest = 0;
+        size_t inFlight = 0;
+        while (nextRequest < requests.size() || inFlight > 0)
+        {
+            while (nextRequest < requests.size() && inFlight < queueDepth)
+            {
+                BlockRequest& request = requests[nextRequest++];
+                if (request.offset == 0 || request.size == 0)
+                {
+                    // Sparse block: nothing stored on disk
+                    fillSparse(buffer, request, nBlockX, nBlockY);
+                    continue;
+                }
+
+                request.data.resize(request.size);
+                io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+                io_uring_prep_read(sqe, fd, request.data.data(), static_cast<unsigned>(request.size), request.offset);
+                io_uring_sqe_set_data(sqe, &request);
+                ++inFlight;
+            }
+
+            if (inFlight == 0)
+                continue;
+
+            if (io_uring_submit(&ring) < 0)
+                return false;
+
+            io_uring_cqe* cqe = nullptr;
+            if (io_uring_wait_cqe(&ring, &cqe) < 0)
+                return false;
+
+            BlockRequest* request = static_cast<BlockRequest*>(io_uring_cqe_get_data(cqe));
+            bool ok = cqe->res == static_cast<int>(request->size);
+            io_uring_cqe_seen(&ring, cqe);
+            --inFlight;
+
+            if (!ok)
+            {
+                drain(inFlight);
+                return false;
+            }
+
+            copyBlock(buffer, *request, nBlockX, nBlockY, nTypeSize);
+            request->data = std::vector<char>();
+        }
+
+        return true;
+    }
+
+private:
+    struct BlockRequest
+    {
+        int band = 0;
+        int blockX = 0;
+        int blockY = 0;
+        unsigned long long offset = 0;
+        unsigned long long size = 0;
+        std::vector<char> data;
+    };
+
+    // Copies the part of a decoded block that overlaps the window
+    void copyBlock(BlockBuffer& buffer, const BlockRequest& request, int nBlockX, int nBlockY, int nTypeSize)
+    {
+        const BlockWindow& w = buffer.window;
+        int nSamples = pixelInterleaved ? poDataset->GetRasterCount() : 1;
+        int blockX0 = request.blockX * nBlockX;
+        int blockY0 = request.blockY * nBlockY;
+        int x0 = std::max(w.x, blockX0);
+        int x1 = std::min(w.x + w.width, blockX0 + nBlockX);
+        int y0 = std::max(w.y, blockY0);
+        int y1 = std::min(w.y + w.height, blockY0 + nBlockY);
+        size_t rowBytes = static_cast<size_t>(nBlockX) * nSamples * nTypeSize;
+
+        for (int y = y0; y < y1; ++y)
+        {
+            size_t rowOffset = static_cast<size_t>(y - blockY0) * rowBytes;
+            // The last strip is stored shorter than the nominal strip size
+            if (rowOffset + static_cast<size_t>(x1 - blockX0) * nSamples * nTypeSize > request.data.size())
+                break;
+
+            const char* src = request.data.data() + rowOffset + static_cast<size_t>(x0 - blockX0) * nSamples * nTypeSize;
+            int firstBand = pixelInterleaved ? 0 : request.band;
+            int lastBand = pixelInterleaved ? static_cast<int>(bands.size()) - 1 : request.band;
+            for (int band = firstBand; band <= lastBand; ++band)
+            {
+                int s = pixelInterleaved ? bands[band] - 1 : 0;
+                char* dst = buffer.bandData[band].data() + (static_cast<size_t>(y - w.y) * w.width + (x0 - w.x)) * nTypeSize;
+                GDALCopyWords(src + s * nTypeSize, buffer.bandTypes[band], nSamples * nTypeSize,
+                              dst, buffer.bandTypes[band], nTypeSize, x1 - x0);
+            }
+        }
+    }
+
+    // Sparse blocks read as nodata (or zero), as GDAL does
+    void fillSparse(BlockBuffer& buffer, const BlockRequest& request, int nBlockX, int nBlockY)
+    {
+        const BlockWindow& w = buffer.window;
+        int x0 = std::max(w.x, request.blockX * nBlockX);
+        int x1 = std::min(w.x + w.width, (request.blockX + 1) * nBlockX);
+        int y0 = std::max(w.y, request.blockY * nBlockY);
+        int y1 = std::min(w.y + w.height, (request.blockY + 1) * nBlockY);
+
+        int firstBand = pixelInterleaved ? 0 : request.band;
+        int lastBand = pixelInterleaved ? static_cast<int>(bands.size()) - 1 : request.band;
+        for (int band = firstBand; band <= lastBand; ++band)
+        {
+            int bHasNoData = FALSE;
+            double noData = poDataset->GetRasterBand(bands[band])->GetNoDataValue(&bHasNoData);
+            double fill = bHasNoData ? noData : 0.0;
+            GDALDataType eType = buffer.bandTypes[band];
+            int nTypeSize = GDALGetDataTypeSizeBytes(eType);
+            for (int y = y0; y < y1; ++y)
+            {
+                char* dst = buffer.bandData[band].data() + (static_cast<size_t>(y - w.y) * w.width + (x0 - w.x)) * nTypeSize;
+                GDALCopyWords(&fill, GDT_Float64, 0, dst, eType, nTypeSize, x1 - x0);
+            }
+        }
+    }
+
+    // Reap outstanding completions so no read targets a freed buffer
+    void drain(size_t inFlight)
+    {
+        while (inFlight > 0)
+        {
+            io_uring_cqe* cqe = nullptr;
+            if (io_uring_wait_cqe(&ring, &cqe) < 0)
+                break;
+            io_uring_cqe_seen(&ring, cqe);
+            --inFlight;
+        }
+    }
+
+    GDALDataset* poDataset;
+    std::vector<int> bands;
+    bool pixelInterleaved = false;
+    int fd = -1;
+    bool ringReady = false;
+    io_uring ring{};
+};
+#endif
+
+// 64-bit xxHash (XXH64); fast enough to hash every decoded window
+static quint64 xxHash64(const void* input, size_t length, quint64 seed)
+{
+    const quint64 prime1 = 0x9E3779B185EBCA87ULL;
+    const quint64 prime2 = 0xC2B2AE3D27D4EB4FULL;
+    const quint64 prime3 = 0x165667B19E3779F9ULL;
+    const quint64 prime4 = 0x85EBCA77C2B2AE63ULL;
+    const quint64 prime5 = 0x27D4EB2F165667C5ULL;
+
+    auto read64 = [](const unsigned char* p) { quint64 v; memcpy(&v, p, 8); return v; };
+    auto read32 = [](const unsigned char* p) { quint32 v; memcpy(&v, p, 4); return v; };
+    auto round = [&](quint64 acc, quint64 lane) { return std::rotl(acc + lane * prime2, 31) * prime1; };
+    auto merge = [&](quint64 acc, quint64 lane) { return (acc ^ round(0, lane)) * prime1 + prime4; };
+
+    const unsigned char* p = static_cast<const unsigned char*>(input);
+    const unsigned char* end = p + length;
+    quint64 h;
+
+    if (length >= 32)
+    {
+        quint64 v1 = seed + prime1 + prime2;
+        quint64 v2 = seed + prime2;
+        quint64 v3 = seed;
+        quint64 v4 = seed - prime1;
+        for (; p + 32 <= end; p += 32)
+        {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+        }
+        h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+        h = merge(h, v1);
+        h = merge(h, v2);
+        h = merge(h, v3);
+        h = merge(h, v4);
+    }
+    else
+    {
+        h = seed + prime5;
+    }
+
+    h += length;
+    for (; p + 8 <= end; p += 8)
+        h = std::rotl(h ^ round(0, read64(p)), 27) * prime1 + prime4;
+    if (p + 4 <= end)
+    {
+        h = std::rotl(h ^ (read32(p) * prime1), 23) * prime2 + prime3;
+        p += 4;
+    }
+    for (; p < end; ++p)
+        h = std::rotl(h ^ (*p * prime5), 11) * prime1;
+
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+// Content hashes of each window's decoded input from the last successful
+// run, kept next to the output. A window whose input hashes the same as
+// last time is neither processed nor rewritten. The signature covers
+// everything else that shapes the output, so any change there rewrites all
+class WindowManifest
+{
+public:
+    explicit WindowManifest(QString path) : path(std::move(path)) {}
+
+    // Loads the previous hashes if they were made for the same job and
+    // layout; the file is removed so an interrupted run cannot leave stale
+    // hashes for windows it already rewrote
+    void begin(const QByteArray& jobSignature, size_t windowCount, bool reuse)
+    {
+        signature = jobSignature;
+        previous.clear();
+        current.assign(windowCount, 0);
+
+        QFile file(path);
+        if (reuse && file.open(QIODevice::ReadOnly))
+        {
+            QList<QByteArray> lines = file.readAll().split('\n');
+            if (lines.size() > static_cast<int>(windowCount) && lines[0].trimmed() == signature)
+            {
+                for (size_t i = 0; i < windowCount; ++i)
+                    previous.push_back(lines[static_cast<int>(i) + 1].trimmed().toULongLong(nullptr, 16));
+            }
+            file.close();
+        }
+        QFile::remove(path);
+    }
+
+    // First line of the stored manifest, empty when there is none
+    QByteArray storedSignature() const
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+            return QByteArray();
+        return file.readLine().trimmed();
+    }
+
+    // Records the hash and tells whether the window can be skipped
+    bool unchanged(size_t index, quint64 hash)
+    {
+        current[index] = hash;
+        return index < previous.size() && previous[index] == hash;
+    }
+
+    bool save() const
+    {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+
+        QByteArray text = signature + '\n';
+        for (quint64 hash : current)
+            text += QByteArray::number(hash, 16) + '\n';
+        file.write(text);
+        return file.commit();
+    }
+
+    static quint64 hash(const BlockBuffer& buffer)
+    {
+        const BlockWindow& w = buffer.window;
+        quint64 h = 0;
+        std::vector<char> packed;
+        for (int b = 0; b < buffer.bandCount(); ++b)
+        {
+            BandView view = buffer.band(b);
+            GDALDataType eType = buffer.bandTypes[b];
+            int nTypeSize = GDALGetDataTypeSizeBytes(eType);
+            h = xxHash64(&eType, sizeof(eType), h);
+            for (int row = 0; row < w.height; ++row)
+            {
+                const char* data = view.data + row * view.lineSpace;
+
+                // Strided rows (e.g. mapped pixel-interleaved input) are packed first
+                if (view.pixelSpace != nTypeSize)
+                {
+                    packed.resize(static_cast<size_t>(nTypeSize) * w.width);
+                    GDALCopyWords(data, eType, static_cast<int>(view.pixelSpace), packed.data(), eType, nTypeSize, w.width);
+                    data = packed.data();
+                }
+                h = xxHash64(data, static_cast<size_t>(nTypeSize) * w.width, h);
+            }
+        }
+        return h;
+    }
+
+private:
+    QString path;
+    QByteArray signature;
+    std::vector<quint64> previous;
+    std::vector<quint64> current;
+};
+
+// Creates a dataset laid out as the grid, with its georeference and nodata
+static GDALDataset* createDataset(const RasterGrid& grid, GDALDriver* poDriver, const QString& path, char** papszOptions)
+{
+    // Create output dataset
+    GDALDataset* poOutDataset = poDriver->Create(
+        path.toStdString().c_str(),
+        grid.xSize,
+        grid.ySize,
+        static_cast<int>(grid.bandTypes.size()),
+        grid.bandTypes[0],
+        papszOptions);
+
+    if (!poOutDataset)
+        return nullptr;
+
+    // Copy projection and geotransform
+    if (!grid.projection.empty())
+    {
+        poOutDataset->SetProjection(grid.projection.c_str());
+    }
+
+    if (grid.hasGeoTransform)
+    {
+        double geoTransform[6];
+        std::copy(grid.geoTransform, grid.geoTransform + 6, geoTransform);
+        poOutDataset->SetGeoTransform(geoTransform);
+    }
+
+    // Areas without input (e.g. outside a reprojected footprint) are written as nodata
+    for (int bandIndex = 1; bandIndex <= static_cast<int>(grid.bandNoData.size()); ++bandIndex)
+    {
+        if (grid.bandNoData[bandIndex - 1])
+        {
+            poOutDataset->GetRasterBand(bandIndex)->SetNoDataValue(*grid.bandNoData[bandIndex - 1]);
+        }
+    }
+
+    return poOutDataset;
+}
+
+// Destination of processed windows. Windows arrive in plan order on the
+// worker thread, after every stage has run
+class BlockSink
+{
+public:
+    virtual ~BlockSink() = default;
+
+    // Block layout the windows should be aligned to; 0 x 0 means none
+    virtual void blockAlignment(int& x, int& y) const { x = y = 0; }
+
+    // The sink may take over the buffer's contents
+    virtual bool write(BlockBuffer& buffer) = 0;
+
+    // Called once after the last window has been written
+    virtual bool finish() { return true; }
+};
+
+// Writes windows into one GDAL dataset
+class DatasetSink : public BlockSink
+{
+public:
+    // Writes stop early once running drops
+    DatasetSink(GDALDataset* poOutDataset, const std::atomic<bool>* running) : poOutDataset(poOutDataset), running(running) {}
+
+    void blockAlignment(int& x, int& y) const override
+    {
+        poOutDataset->GetRasterBand(1)->GetBlockSize(&x, &y);
+    }
+
+    bool write(BlockBuffer& buffer) override
+    {
+        const BlockWindow& w = buffer.window;
+        GDALRasterIOExtraArg extraArg = cancellableIO(running);
+        for (int bandIndex = 1; bandIndex <= buffer.bandCount(); ++bandIndex)
+        {
+            GDALRasterBand* poOutBand = poOutDataset->GetRasterBand(bandIndex);
+            GDALDataType eType = buffer.bandTypes[bandIndex - 1];
+            BandView view = buffer.band(bandIndex - 1);
+
+            // Strided views (e.g. mapped input) are written without repacking
+            CPLErr err = poOutBand->RasterIO(GF_Write, w.x, w.y, w.width, w.height, const_cast<char*>(view.data), w.width, w.height, eType, view.pixelSpace, view.lineSpace, &extraArg);
+            if (err != CE_None)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    GDALDataset* poOutDataset;
+    const std::atomic<bool>* running;
+};
+
+// Cuts a Web Mercator grid aligned to the tile matrix of maxZoom into 256 px
+// z/x/y tiles. Lower zooms are built from the tiles already cut: each tile
+// is averaged down into a quadrant of its parent, which is emitted once all
+// of its children have arrived. Tiles are encoded in parallel on a pool of
+// their own, with a bounded number waiting
+class TilePyramidSink : public BlockSink
+{
+public:
+    static constexpr int TileSize = 256;
+    static constexpr double OriginShift = 20037508.342789244;
+
+    enum Scheme { XYZ, TMS };
+
+    // Pixel size in metres of zoom level z
+    static double resolution(int z)
+    {
+        return 2.0 * OriginShift / (TileSize * std::ldexp(1.0, z));
+    }
+
+    // Queued tiles are dropped once running drops
+    TilePyramidSink(const RasterGrid& grid, const QString& directory, const QString& format, Scheme scheme,
+                    int minZoom, int maxZoom, int threads, const std::atomic<bool>* running)
+        : directory(directory), format(format), scheme(scheme), minZoom(minZoom), maxZoom(maxZoom),
+          bandCount(static_cast<int>(grid.bandTypes.size())), noData(grid.bandNoData), running(running), encodeSlots(threads * 4)
+    {
+        double tileSpan = TileSize * resolution(maxZoom);
+        tileX0 = static_cast<int>(std::lround((grid.geoTransform[0] + OriginShift) / tileSpan));
+        tileY0 = static_cast<int>(std::lround((OriginShift - grid.geoTransform[3]) / tileSpan));
+
+        // Tile range of every zoom, from the grid's range at maxZoom down
+        ranges.resize(maxZoom + 1);
+        ranges[maxZoom] = {tileX0, tileY0, tileX0 + (grid.xSize + TileSize - 1) / TileSize - 1,
+                           tileY0 + (grid.ySize + TileSize - 1) / TileSize - 1};
+        for (int z = maxZoom - 1; z >= minZoom; --z)
+        {
+            const TileRange& child = ranges[z + 1];
+            ranges[z] = {child.x0 / 2, child.y0 / 2, child.x1 / 2, child.y1 / 2};
+        }
+
+        pool.setMaxThreadCount(threads);
+    }
+
+    void blockAlignment(int& x, int& y) const override
+    {
+        x = y = TileSize;
+    }
+
+    bool write(BlockBuffer& buffer) override
+    {
+        const BlockWindow& w = buffer.window;
+        for (int ty = 0; ty * TileSize < w.height; ++ty)
+        {
+            for (int tx = 0; tx * TileSize < w.width; ++tx)
+            {
+                Image tile = cut(buffer, tx * TileSize, ty * TileSize);
+                add(maxZoom, tileX0 + (w.x / TileSize) + tx, tileY0 + (w.y / TileSize) + ty, std::move(tile));
+            }
+        }
+        return !failed.load();
+    }
+
+    bool finish() override
+    {
+        pool.waitForDone();
+        return !failed.load();
+    }
+
+    ~TilePyramidSink() override
+    {
+        pool.waitForDone();
+    }
+
+private:
+    // RGBA, TileSize x TileSize, row-major
+    typedef std::vector<unsigned char> Image;
+
+    struct TileRange
+    {
+        int x0 = 0;
+        int y0 = 0;
+        int x1 = -1;
+        int y1 = -1;
+
+        bool contains(int x, int y) const { return x >= x0 && x <= x1 && y >= y0 && y <= y1; }
+    };
+
+    struct Pending
+    {
+        Image image;
+        int received = 0;
+    };
+
+    // Maps the window's bands to RGBA: one band is grey, three are RGB and a
+    // second or fourth band is alpha; otherwise nodata pixels are transparent
+    Image cut(const BlockBuffer& buffer, int x0, int y0) const
+    {
+        Image tile(static_cast<size_t>(TileSize) * TileSize * 4, 0);
+        const BlockWindow& w = buffer.window;
+        int width = std::min(TileSize, w.width - x0);
+        int height = std::min(TileSize, w.height - y0);
+        int nColor = bandCount >= 3 ? 3 : 1;
+        int alphaBand = bandCount == 2 ? 1 : (bandCount >= 4 ? 3 : -1);
+
+        std::vector<double> row(width);
+        std::vector<unsigned char> transparent(static_cast<size_t>(width) * height, alphaBand < 0 && noData[0] ? 1 : 0);
+        for (int b = 0; b < std::min(bandCount, 4); ++b)
+        {
+            BandView view = buffer.band(b);
+            for (int y = 0; y < height; ++y)
+            {
+                GDALCopyWords(view.data + (y0 + y) * view.lineSpace + x0 * view.pixelSpace, buffer.bandTypes[b], static_cast<int>(view.pixelSpace),
+                              row.data(), GDT_Float64, sizeof(double), width);
+                unsigned char* out = tile.data() + static_cast<size_t>(y) * TileSize * 4;
+                for (int x = 0; x < width; ++x)
+                {
+                    double clamped = std::isnan(row[x]) ? 0.0 : std::clamp(row[x], 0.0, 255.0);
+                    unsigned char value = static_cast<unsigned char>(std::lround(clamped));
+                    if (b == alphaBand)
+                    {
+                        out[x * 4 + 3] = value;
+                        continue;
+                    }
+                    if (b >= nColor)
+                        continue;
+                    for (int c = (nColor == 1 ? 0 : b); c < (nColor == 1 ? 3 : b + 1); ++c)
+                        out[x * 4 + c] = value;
+                    if (alphaBand < 0 && noData[b] && row[x] != *noData[b] && !std::isnan(row[x]))
+                        transparent[static_cast<size_t>(y) * width + x] = 0;
+                }
+            }
+        }
+
+        if (alphaBand < 0)
+        {
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                    tile[(static_cast<size_t>(y) * TileSize + x) * 4 + 3] = transparent[static_cast<size_t>(y) * width + x] ? 0 : 255;
+            }
+        }
+        return tile;
+    }
+
+    void add(int z, int x, int y, Image tile)
+    {
+        bool empty = true;
+        for (size_t i = 3; i < tile.size(); i += 4)
+        {
+            if (tile[i] != 0)
+            {
+                empty = false;
+                break;
+            }
+        }
+
+        if (z > minZoom)
+        {
+            int px = x / 2;
+            int py = y / 2;
+            quint64 key = (static_cast<quint64>(z - 1) << 58) | (static_cast<quint64>(px) << 29) | static_cast<quint64>(py);
+            Pending& parent = pending[key];
+            if (parent.image.empty())
+                parent.image.assign(static_cast<size_t>(TileSize) * TileSize * 4, 0);
+            if (!empty)
+                downsampleInto(tile, parent.image, (x % 2) * TileSize / 2, (y % 2) * TileSize / 2);
+
+            if (++parent.received == expectedChildren(z - 1, px, py))
+            {
+                Image image = std::move(parent.image);
+                pending.erase(key);
+                add(z - 1, px, py, std::move(image));
+            }
+        }
+
+        // Fully transparent tiles are not written
+        if (!empty)
+            encode(z, x, y, std::move(tile));
+    }
+
+    int expectedChildren(int z, int x, int y) const
+    {
+        int count = 0;
+        for (int cy = 2 * y; cy <= 2 * y + 1; ++cy)
+        {
+            for (int cx = 2 * x; cx <= 2 * x + 1; ++cx)
+                count += ranges[z + 1].contains(cx, cy) ? 1 : 0;
+        }
+        return count;
+    }
+
+    // 2x2 box filter weighted by alpha, so transparent pixels do not darken edges
+    static void downsampleInto(const Image& child, Image& parent, int offsetX, int offsetY)
+    {
+        for (int y = 0; y < TileSize / 2; ++y)
+        {
+            for (int x = 0; x < TileSize / 2; ++x)
+            {
+                unsigned sum[3] = {0, 0, 0};
+                unsigned alpha = 0;
+                for (int dy = 0; dy < 2; ++dy)
+                {
+                    for (int dx = 0; dx < 2; ++dx)
+                    {
+                        const unsigned char* p = child.data() + ((static_cast<size_t>(2 * y + dy) * TileSize) + 2 * x + dx) * 4;
+                        for (int c = 0; c < 3; ++c)
+                            sum[c] += p[c] * p[3];
+                        alpha += p[3];
+                    }
+                }
+
+                unsigned char* out = parent.data() + ((static_cast<size_t>(offsetY + y) * TileSize) + offsetX + x) * 4;
+                for (int c = 0; c < 3; ++c)
+                    out[c] = static_cast<unsigned char>(alpha ? (sum[c] + alpha / 2) / alpha : 0);
+                out[3] = static_cast<unsigned char>((alpha + 2) / 4);
+            }
+        }
+    }
+
+    void encode(int z, int x, int y, Image tile)
+    {
+        int row = scheme == TMS ? (1 << z) - 1 - y : y;
+        QString folder = QString("%1/%2/%3").arg(directory).arg(z).arg(x);
+        QString extension = format == "JPEG" ? "jpg" : format.toLower();
+        QString path = QString("%1/%2.%3").arg(folder).arg(row).arg(extension);
+
+        encodeSlots.acquire();
+        pool.start(new EncodeTask(*this, std::move(tile), folder, path));
+    }
+
+    class EncodeTask : public QRunnable
+    {
+    public:
+        EncodeTask(TilePyramidSink& sink, Image tile, QString folder, QString path)
+            : sink(sink), tile(std::move(tile)), folder(std::move(folder)), path(std::move(path))
+        {
+            setAutoDelete(true);
+        }
+
+        void run() override
+        {
+            // Dropped once cancelled; the slot is still released
+            bool cancelled = sink.running && !sink.running->load();
+            if (!cancelled && !sink.writeTile(tile, folder, path))
+                sink.failed.store(true);
+            sink.encodeSlots.release();
+        }
+
+    private:
+        TilePyramidSink& sink;
+        Image tile;
+        QString folder;
+        QString path;
+    };
+
+    bool writeTile(Image& tile, const QString& folder, const QString& path) const
+    {
+        if (!QDir().mkpath(folder))
+            return false;
+
+        GDALDriver* poMemDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+        GDALDriver* poTileDriver = GetGDALDriverManager()->GetDriverByName(format.toStdString().c_str());
+        if (!poMemDriver || !poTileDriver)
+            return false;
+
+        // JPEG has no alpha channel
+        int nBands = format == "JPEG" ? 3 : 4;
+        GDALDataset* poTile = poMemDriver->Create("", TileSize, TileSize, nBands, GDT_Byte, nullptr);
+        if (!poTile)
+            return false;
+
+        bool ok = poTile->RasterIO(GF_Write, 0, 0, TileSize, TileSize, tile.data(), TileSize, TileSize, GDT_Byte,
+                                   nBands, nullptr, 4, static_cast<GSpacing>(TileSize) * 4, 1) == CE_None;
+        if (ok)
+        {
+            GDALDataset* poOut = poTileDriver->CreateCopy(path.toStdString().c_str(), poTile, FALSE, nullptr, nullptr, nullptr);
+            ok = poOut != nullptr;
+            if (poOut)
+                GDALClose(poOut);
+        }
+        GDALClose(poTile);
+        return ok;
+    }
+
+    QString directory;
+    QString format;
+    Scheme scheme;
+    int minZoom;
+    int maxZoom;
+    int bandCount;
+    std::vector<std::optional<double>> noData;
+    int tileX0 = 0;
+    int tileY0 = 0;
+    std::vector<TileRange> ranges;
+    std::map<quint64, Pending> pending;
+    const std::atomic<bool>* running;
+
+    QThreadPool pool;
+    QSemaphore encodeSlots;
+    std::atomic<bool> failed{false};
+};
+
+// Writes the grid as a set of separate files, each covering one rectangle
+// of it. A window's pieces are handed to a pool so different files are
+// written by different threads; writes to one file are serialised. A file
+// is created when its first window arrives and closed after its last, so
+// only the files being written are open. Files for CreateCopy-only drivers
+// are staged as GTiff and converted, in parallel, at the end
+class SplitSink : public BlockSink
+{
+public:
+    struct Part
+    {
+        BlockWindow area;
+        RasterGrid grid;
+        QString path;
+        QString stagingPath;
+        GDALDataset* poDataset = nullptr;   // the file itself, or its staging GTiff, while it is written
+        qint64 remaining = 0;               // pixels still to be written
+        bool created = false;               // poDataset was created; worker thread only
+        bool written = false;               // path was created by this job
+    };
+
+    // poPartDriver creates the parts, or their staging files when
+    // poCopyDriver is given
+    SplitSink(std::vector<Part> parts, GDALDriver* poPartDriver, char** papszPartOptions, GDALDriver* poCopyDriver, char** papszCopyOptions,
+              int threads, const std::atomic<bool>* running)
+        : parts(std::move(parts)), poPartDriver(poPartDriver), papszPartOptions(papszPartOptions), poCopyDriver(poCopyDriver),
+          papszCopyOptions(papszCopyOptions), running(running), partMutexes(this->parts.size()), writeSlots(threads * 2)
+    {
+        pool.setMaxThreadCount(threads);
+        for (Part& part : this->parts)
+            part.remaining = static_cast<qint64>(part.area.width) * part.area.height;
+    }
+
+    // Staging files left by a cancelled or failed job, which never ran
+    // finish()'s copies, are removed here; a failed job also removes the
+    // parts it wrote
+    ~SplitSink() override
+    {
+        pool.waitForDone();
+        GDALDriver* poStagingDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+        GDALDriver* poFinalDriver = poCopyDriver ? poCopyDriver : poPartDriver;
+        for (Part& part : parts)
+        {
+            if (part.poDataset)
+                GDALClose(part.poDataset);
+            if (!part.stagingPath.isEmpty() && poStagingDriver && QFileInfo::exists(part.stagingPath))
+                poStagingDriver->Delete(part.stagingPath.toStdString().c_str());
+            if (failed.load() && part.written && QFileInfo::exists(part.path))
+                poFinalDriver->Delete(part.path.toStdString().c_str());
+        }
+    }
+
+    // Hands over the buffer; the pieces are written from it asynchronously
+    bool write(BlockBuffer& buffer) override
+    {
+        auto shared = std::make_shared<BlockBuffer>(std::move(buffer));
+        const BlockWindow& w = shared->window;
+        for (size_t i = 0; i < parts.size(); ++i)
+        {
+            const BlockWindow& area = parts[i].area;
+            int x0 = std::max(w.x, area.x);
+            int y0 = std::max(w.y, area.y);
+            int x1 = std::min(w.x + w.width, area.x + area.width);
+            int y1 = std::min(w.y + w.height, area.y + area.height);
+            if (x1 <= x0 || y1 <= y0)
+                continue;
+
+            // No piece of this part is queued before it exists
+            Part& part = parts[i];
+            if (!part.created)
+            {
+                part.poDataset = createDataset(part.grid, poPartDriver, part.stagingPath.isEmpty() ? part.path : part.stagingPath, papszPartOptions);
+                if (!part.poDataset)
+                {
+                    failed.store(true);
+                    return false;
+                }
+                part.created = true;
+                part.written = part.stagingPath.isEmpty();
+            }
+
+            writeSlots.acquire();
+            pool.start(new PieceTask(*this, shared, i, {x0, y0, x1 - x0, y1 - y0}));
+        }
+        return !failed.load();
+    }
+
+    bool finish() override
+    {
+        pool.waitForDone();
+        if (failed.load() || !poCopyDriver)
+            return !failed.load();
+
+        for (size_t i = 0; i < parts.size(); ++i)
+            pool.start(new CopyTask(*this, i));
+        pool.waitForDone();
+        return !failed.load();
+    }
+
+private:
+    // Writes the part of a window that falls in one file
+    class PieceTask : public QRunnable
+    {
+    public:
+        PieceTask(SplitSink& sink, std::shared_ptr<BlockBuffer> buffer, size_t index, BlockWindow piece)
+            : sink(sink), buffer(std::move(buffer)), index(index), piece(piece)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() override
+        {
+            Part& part = sink.parts[index];
+            const BlockWindow& w = buffer->window;
+            QMutexLocker locker(&sink.partMutexes[index]);
+            GDALRasterIOExtraArg extraArg = cancellableIO(sink.running);
+            bool complete = true;
+            for (int b = 0; b < buffer->bandCount(); ++b)
+            {
+                // Queued pieces are dropped once cancelled; the slot is still released
+                if (sink.running && !sink.running->load())
+                {
+                    complete = false;
+                    break;
+                }
+
+                BandView view = buffer->band(b);
+                char* data = const_cast<char*>(view.data) + (piece.y - w.y) * view.lineSpace + (piece.x - w.x) * view.pixelSpace;
+                CPLErr err = part.poDataset->GetRasterBand(b + 1)->RasterIO(GF_Write, piece.x - part.area.x, piece.y - part.area.y,
+                                                                           piece.width, piece.height, data, piece.width, piece.height,
+                                                                           buffer->bandTypes[b], view.pixelSpace, view.lineSpace, &extraArg);
+                if (err != CE_None)
+                {
+                    sink.failed.store(true);
+                    complete = false;
+                    break;
+                }
+            }
+
+            // The part's last piece closes it
+            part.remaining -= complete ? static_cast<qint64>(piece.width) * piece.height : 0;
+            if (part.remaining == 0)
+            {
+                GDALClose(part.poDataset);
+                part.poDataset = nullptr;
+            }
+            sink.writeSlots.release();
+        }
+
+    private:
+        SplitSink& sink;
+        std::shared_ptr<BlockBuffer> buffer;
+        size_t index;
+        BlockWindow piece;
+    };
+
+    // Converts one staged file with the CreateCopy-only driver
+    class CopyTask : public QRunnable
+    {
+    public:
+        CopyTask(SplitSink& sink, size_t index) : sink(sink), index(index)
+        {
+            setAutoDelete(true);
+        }
+
+        void run() override
+        {
+            Part& part = sink.parts[index];
+            GDALDataset* poStaged = static_cast<GDALDataset*>(GDALOpenEx(part.stagingPath.toStdString().c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY,
+                                                                         nullptr, nullptr, nullptr));
+            GDALDataset* poCopy = poStaged ? sink.poCopyDriver->CreateCopy(part.path.toStdString().c_str(), poStaged, FALSE,
+                                                                           sink.papszCopyOptions, sink.running ? continueWhileRunning : nullptr,
+                                                                           const_cast<std::atomic<bool>*>(sink.running))
+                                           : nullptr;
+            if (!poCopy)
+                sink.failed.store(true);
+            else
+            {
+                part.written = true;
+                GDALClose(poCopy);
+            }
+
+            if (poStaged)
+                GDALClose(poStaged);
+            GDALDriver* poStagingDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+            if (poStagingDriver)
+                poStagingDriver->Delete(part.stagingPath.toStdString().c_str());
+        }
+
+    private:
+        SplitSink& sink;
+        size_t index;
+    };
+
+    std::vector<Part> parts;
+    GDALDriver* poPartDriver;
+    char** papszPartOptions;
+    GDALDriver* poCopyDriver;
+    char** papszCopyOptions;
+    const std::atomic<bool>* running;
+    std::vector<QMutex> partMutexes;
+
+    QThreadPool pool;
+    QSemaphore writeSlots;
+    std::atomic<bool> failed{false};
+};
+
+// Windows a job may have in flight in a shared pool. The daemon's
+// scheduler changes it at any time; the worker picks the new value up
+// between batches and waits while it is zero
+class WindowQuota
+{
+public:
+    explicit WindowQuota(int windows) : windows(windows) {}
+
+    void set(int value)
+    {
+        QMutexLocker locker(&mutex);
+        windows = value;
+        changed.wakeAll();
+    }
+
+    // The current quota, once it is non-zero; 0 only after cancellation
+    int acquire(const std::atomic<bool>& running)
+    {
+        QMutexLocker locker(&mutex);
+        while (windows == 0 && running.load())
+            changed.wait(&mutex, 100); // wakes up to notice cancellation
+        return running.load() ? windows : 0;
+    }
+
+private:
+    QMutex mutex;
+    QWaitCondition changed;
+    int windows;
+};
 
 // Worker class to handle conversion in a separate thread
 class Worker : public QObject
 {
-    Q_OBJECT
+    Q_OBJECT
+
+public:
+    // CPU runs the scalar reference kernels, SIMD the vectorised ones
+    enum ProcessingMode { CPU, SIMD };
+    Q_ENUM(ProcessingMode)
+
+    Worker(QString inputPath, QString outputPath, QString inputDriverName, QString outputDriverName, QMap<QString, QString> options, ProcessingMode mode, int numCores, ConversionSettings settings)
+        : inputFile(std::move(inputPath)), outputFile(std::move(outputPath)),
+          inputDriverName(std::move(inputDriverName)), outputDriverName(std::move(outputDriverName)),
+          gdalOptions(std::move(options)), isConverting(true), processingMode(mode), numCores(numCores),
+          settings(settings) {}
+
+    ~Worker() override = default;
+
+public slots:
+    void process()
+    {
+        emit logMessage("Starting GDAL conversion...");
+
+        // The profile covers this thread, which opens, reads and writes the
+        // datasets (mosaic sources, read on pool threads, keep the defaults);
+        // jobs on a shared pool leave the block cache to the daemon
+        std::optional<ScopedGdalConfig> gdalConfig;
+        if (!settings.gdalProfile.isEmpty())
+        {
+            const GdalProfile* profile = findGdalProfile(settings.gdalProfile);
+            if (!profile)
+            {
+                emit finished(false, "Unknown GDAL profile: " + settings.gdalProfile);
+                return;
+            }
+            int maxThreads = sharedPool ? numCores : 0;
+            gdalConfig.emplace(*profile, !sharedPool, maxThreads);
+            emit logMessage("GDAL profile " + profile->name + ": " + profile->describe(maxThreads, !sharedPool) +
+                            (sharedPool && profile->cacheMB > 0 ? " (block cache left to the daemon)." : "."));
+        }
+
+        // Open the input file
+        GDALDataset* poDataset = static_cast<GDALDataset*>(GDALOpenEx(
+            inputFile.toStdString().c_str(), GDAL_OF_READONLY, nullptr, nullptr, nullptr));
+
+        if (!poDataset)
+        {
+            QString errorMsg = "Failed to open input file: " + inputFile + "\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+            emit finished(false, errorMsg);
+            return;
+        }
+
+        emit logMessage("Input file opened successfully.");
+
+        // Get the output driver
+        GDALDriver* poOutDriver = GetGDALDriverManager()->GetDriverByName(outputDriverName.toStdString().c_str());
+        if (!poOutDriver)
+        {
+            QString errorMsg = "Output driver not available: " + outputDriverName;
+            GDALClose(poDataset);
+            emit finished(false, errorMsg);
+            return;
+        }
+
+        emit logMessage("Output driver found: " + outputDriverName);
+
+        // Set creation options for the output file
+        char** papszOptions = nullptr;
+        for (auto it = gdalOptions.begin(); it != gdalOptions.end(); ++it)
+        {
+            papszOptions = CSLSetNameValue(papszOptions, it.key().toStdString().c_str(), it.value().toStdString().c_str());
+            emit logMessage(QString("Setting GDAL option: %1 = %2").arg(it.key(), it.value()));
+        }
+
+        // Let GDAL compress output tiles in parallel
+        papszOptions = applyCompressionThreading(papszOptions);
+
+        // Set up the bands and processing stages requested for this job
+        if (!selectBands(poDataset) || !buildStages(poDataset))
+        {
+            GDALClose(poDataset);
+            CSLDestroy(papszOptions);
+            return;
+        }
+
+        // Check if driver supports Create method
+        bool bCreateSupported = poOutDriver->GetMetadataItem(GDAL_DCAP_CREATE) != nullptr;
+
+        // Select the compute backend for the per-block kernels
+        if (processingMode == CPU)
+        {
+            backend = &ComputeBackend::scalar();
+        }
+        else if (processingMode == SIMD)
+        {
+            backend = &ComputeBackend::simd();
+        }
+        else
+        {
+            // Unknown processing mode
+            GDALClose(poDataset);
+            CSLDestroy(papszOptions);
+            emit finished(false, "Unknown processing mode selected.");
+            return;
+        }
+
+        emit logMessage(QString("Processing mode: %1 (%2 kernels)").arg(processingMode == CPU ? "CPU" : "SIMD").arg(backend->name()));
+
+        if (settings.shardCount > 1 && (settings.tileMode != ConversionSettings::NoTiles || splitsOutput()))
+        {
+            GDALClose(poDataset);
+            CSLDestroy(papszOptions);
+            emit finished(false, "Sharding writes one part file per shard; it cannot be combined with tiles or split output.");
+            return;
+        }
+
+        if (settings.shardCount > 1 && !outputGrid(poDataset).northUp())
+        {
+            GDALClose(poDataset);
+            CSLDestroy(papszOptions);
+            emit finished(false, "Shard parts are merged by georeference, so sharding needs a north-up georeferenced output; "
+                                 "reproject to a target CRS or convert without sharding.");
+            return;
+        }
+
+        if (settings.shardCount > 1)
+        {
+            // A part or marker left by an earlier run must not be merged
+            QString marker = emptyShardMarker(outputFile);
+            QFile::remove(marker);
+            if (outputGrid(poDataset).ySize == 0)
+            {
+                GDALClose(poDataset);
+                CSLDestroy(papszOptions);
+                QFile::remove(outputFile);
+                QFile markerFile(marker);
+                if (!markerFile.open(QIODevice::WriteOnly))
+                {
+                    emit finished(false, "Failed to write the empty-shard marker: " + marker);
+                    return;
+                }
+                emit finished(true, "This shard has no output rows; marked it empty instead of writing a part.");
+                return;
+            }
+        }
+
+        if (settings.incremental && (settings.tileMode != ConversionSettings::NoTiles || splitsOutput() || !bCreateSupported || isMosaic()))
+        {
+            emit logMessage("Incremental updates need a single-file output from a Create-capable driver and a single input; converting everything.");
+            settings.incremental = false;
+        }
+
+        if (settings.tileMode != ConversionSettings::NoTiles)
+        {
+            // The output path is the tile folder; no dataset is created
+            if (!processTiles(poDataset))
+            {
+                GDALClose(poDataset);
+                CSLDestroy(papszOptions);
+                return;
+            }
+        }
+        else if (splitsOutput())
+        {
+            if (!processSplit(poDataset, poOutDriver, papszOptions, bCreateSupported))
+            {
+                GDALClose(poDataset);
+                CSLDestroy(papszOptions);
+                return;
+            }
+        }
+        else if (bCreateSupported)
+        {
+            // Proceed with Create method
+            if (!processWithCreateMethod(poDataset, poOutDriver, papszOptions))
+            {
+                GDALClose(poDataset);
+                CSLDestroy(papszOptions);
+                return;
+            }
+        }
+        else if (poOutDriver->GetMetadataItem(GDAL_DCAP_CREATECOPY) != nullptr)
+        {
+            // Use CreateCopy method
+            if (!processWithCreateCopyMethod(poDataset, poOutDriver, papszOptions))
+            {
+                GDALClose(poDataset);
+                CSLDestroy(papszOptions);
+                return;
+            }
+        }
+        else
+        {
+            QString errorMsg = "Output driver does not support Create or CreateCopy methods.";
+            GDALClose(poDataset);
+            CSLDestroy(papszOptions);
+            emit finished(false, errorMsg);
+            return;
+        }
+
+        GDALClose(poDataset);
+        CSLDestroy(papszOptions);
+
+        emit logMessage("Conversion process completed successfully.");
+        emit finished(true, "Conversion completed successfully: " + outputFile);
+    }
+
+    // GDAL polls the flag between blocks of a RasterIO or CreateCopy, and
+    // stages between runs, so a cancel lands within about one block's work
+    void requestInterruption()
+    {
+        qint64 expected = 0;
+        cancelRequestedAt.compare_exchange_strong(expected, std::chrono::steady_clock::now().time_since_epoch().count());
+        isConverting.store(false, std::memory_order_relaxed);
+    }
+
+    // Milliseconds from the cancel request until now, or -1 without one
+    qint64 cancelLatencyMs() const
+    {
+        qint64 requested = cancelRequestedAt.load();
+        if (requested == 0)
+            return -1;
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::duration(std::chrono::steady_clock::now().time_since_epoch().count() - requested)).count();
+    }
+
+    // Cancels slower than this point at a RasterIO or stage that does not poll
+    static constexpr qint64 CancelLatencyTargetMs = 500;
+
+    // Runs block processing on a pool owned by the caller instead of a
+    // pool of numCores threads created per job. With a quota, batches are
+    // sized by it instead of numCores
+    void setThreadPool(QThreadPool* pool, std::shared_ptr<WindowQuota> quota = nullptr)
+    {
+        sharedPool = pool;
+        windowQuota = std::move(quota);
+    }
+
+signals:
+    void progressUpdated(float progress);
+    void finished(bool success, const QString &message);
+    void logMessage(const QString &message);
+
+private:
+    char** applyCompressionThreading(char** papszOptions)
+    {
+        // Only GTiff and COG have a multithreaded block encoder
+        if (outputDriverName != "GTiff" && outputDriverName != "COG")
+            return papszOptions;
+
+        const char* compress = CSLFetchNameValue(papszOptions, "COMPRESS");
+        if (!compress || EQUAL(compress, "NONE"))
+            return papszOptions;
+
+        // Respect an explicit user choice
+        if (CSLFetchNameValue(papszOptions, "NUM_THREADS") != nullptr)
+            return papszOptions;
+
+        // A GDAL profile's GDAL_NUM_THREADS decides over the job's core
+        // count; daemon jobs never go past their own share of the pool
+        int threads = numCores;
+        const GdalProfile* profile = findGdalProfile(settings.gdalProfile);
+        if (profile && profile->codecThreads() > 0)
+            threads = sharedPool ? std::min(profile->codecThreads(), numCores) : profile->codecThreads();
+
+        if (threads > 1)
+            papszOptions = CSLSetNameValue(papszOptions, "NUM_THREADS", QString::number(threads).toStdString().c_str());
+        emit logMessage(QString("Compressing %1 output with %2 thread(s).").arg(compress).arg(threads));
+        return papszOptions;
+    }
+
+    // Parses the band selection; only these bands are read from the input
+    bool selectBands(GDALDataset* poDataset)
+    {
+        int nBands = poDataset->GetRasterCount();
+        sourceBands.clear();
+
+        QString selection = settings.bandSelection.trimmed();
+        if (selection.isEmpty())
+        {
+            for (int bandIndex = 1; bandIndex <= nBands; ++bandIndex)
+                sourceBands.push_back(bandIndex);
+            return true;
+        }
+
+        const QStringList parts = selection.split(',', Qt::SkipEmptyParts);
+        for (const QString& part : parts)
+        {
+            QStringList range = part.trimmed().split('-');
+            bool okFirst = false;
+            bool okLast = range.size() == 1;
+            int first = range[0].trimmed().toInt(&okFirst);
+            int last = range.size() == 2 ? range[1].trimmed().toInt(&okLast) : first;
+            if (!okFirst || !okLast || range.size() > 2 || first < 1 || last < 1 || first > nBands || last > nBands)
+            {
+                emit finished(false, QString("Invalid band selection \"%1\": the input has %2 band(s).").arg(part.trimmed()).arg(nBands));
+                return false;
+            }
+
+            // Descending ranges such as "3-1" reverse the order
+            int step = last >= first ? 1 : -1;
+            for (int bandIndex = first; bandIndex != last + step; bandIndex += step)
+                sourceBands.push_back(bandIndex);
+        }
+
+        if (sourceBands.empty())
+        {
+            emit finished(false, "The band selection is empty.");
+            return false;
+        }
+
+        QStringList names;
+        for (int bandIndex : sourceBands)
+            names << QString::number(bandIndex);
+        emit logMessage(QString("Reading %1 of %2 band(s): %3").arg(sourceBands.size()).arg(nBands).arg(names.join(",")));
+        return true;
+    }
+
+    // True when the selection is anything other than every band in order
+    bool subsetsBands(GDALDataset* poDataset) const
+    {
+        if (static_cast<int>(sourceBands.size()) != poDataset->GetRasterCount())
+            return true;
+        for (size_t i = 0; i < sourceBands.size(); ++i)
+        {
+            if (sourceBands[i] != static_cast<int>(i) + 1)
+                return true;
+        }
+        return false;
+    }
+
+    // Converts the subset setting to a pixel window clipped to the input;
+    // a bounding box is widened to whole pixels
+    bool subsetWindow(const RasterGrid& grid, BlockWindow& window)
+    {
+        QStringList parts = settings.subset.split(',', Qt::SkipEmptyParts);
+        double values[4];
+        bool valid = parts.size() == 4;
+        for (int i = 0; valid && i < 4; ++i)
+            values[i] = parts[i].trimmed().toDouble(&valid);
+        if (!valid)
+        {
+            emit finished(false, "The subset needs four comma-separated numbers: " + settings.subset);
+            return false;
+        }
+
+        int nXSize = grid.xSize;
+        int nYSize = grid.ySize;
+        double x0 = values[0];
+        double y0 = values[1];
+        double x1 = values[0] + values[2];
+        double y1 = values[1] + values[3];
+
+        if (settings.subsetMode == ConversionSettings::BoundingBox)
+        {
+            double geoTransform[6];
+            double inverse[6];
+            std::copy(grid.geoTransform, grid.geoTransform + 6, geoTransform);
+            if (!grid.hasGeoTransform || !GDALInvGeoTransform(geoTransform, inverse))
+            {
+                emit finished(false, "A bounding box subset needs an input with a geotransform.");
+                return false;
+            }
+
+            // Corners of the box in pixel space; rotated grids give a larger window
+            x0 = y0 = std::numeric_limits<double>::max();
+            x1 = y1 = std::numeric_limits<double>::lowest();
+            const double corners[4][2] = {{values[0], values[1]}, {values[0], values[3]}, {values[2], values[1]}, {values[2], values[3]}};
+            for (const auto& corner : corners)
+            {
+                double px = 0.0;
+                double py = 0.0;
+                GDALApplyGeoTransform(inverse, corner[0], corner[1], &px, &py);
+                x0 = std::min(x0, px);
+                x1 = std::max(x1, px);
+                y0 = std::min(y0, py);
+                y1 = std::max(y1, py);
+            }
+        }
+
+        int ix0 = static_cast<int>(std::clamp(std::floor(x0 + 1e-6), 0.0, static_cast<double>(nXSize)));
+        int iy0 = static_cast<int>(std::clamp(std::floor(y0 + 1e-6), 0.0, static_cast<double>(nYSize)));
+        int ix1 = static_cast<int>(std::clamp(std::ceil(x1 - 1e-6), 0.0, static_cast<double>(nXSize)));
+        int iy1 = static_cast<int>(std::clamp(std::ceil(y1 - 1e-6), 0.0, static_cast<double>(nYSize)));
+        if (ix1 <= ix0 || iy1 <= iy0)
+        {
+            emit finished(false, "The subset does not intersect the input: " + settings.subset);
+            return false;
+        }
+
+        window = {ix0, iy0, ix1 - ix0, iy1 - iy0};
+        return true;
+    }
+
+    bool buildStages(GDALDataset* poDataset)
+    {
+        stages.clear();
+
+        if (isMosaic())
+        {
+            QString error;
+            std::unique_ptr<MosaicStage> mosaic = MosaicStage::create(settings.mosaicInputs, outputGrid(poDataset), sourceBands, settings.compositeRule, error);
+            if (!mosaic)
+            {
+                emit finished(false, error);
+                return false;
+            }
+            RasterGrid grid = mosaic->outputGrid(outputGrid(poDataset));
+            emit logMessage(QString("Mosaicking %1 files: %2 x %3 pixels.").arg(mosaic->sourceCount()).arg(grid.xSize).arg(grid.ySize));
+            mosaic->setRunningFlag(&isConverting);
+            stages.push_back(std::move(mosaic));
+        }
+
+        if (settings.subsetMode != ConversionSettings::NoSubset && !settings.subset.trimmed().isEmpty())
+        {
+            BlockWindow window;
+            if (!subsetWindow(outputGrid(poDataset), window))
+                return false;
+
+            emit logMessage(QString("Extracting pixels %1,%2 (%3 x %4).").arg(window.x).arg(window.y).arg(window.width).arg(window.height));
+            stages.push_back(std::make_unique<CropStage>(window));
+        }
+
+        bool tiles = settings.tileMode != ConversionSettings::NoTiles;
+        if (tiles)
+        {
+            if (!settings.targetSrs.isEmpty())
+                emit logMessage("Web tiles are always cut in EPSG:3857; the target CRS is ignored.");
+            if (!buildTileGrid(poDataset))
+                return false;
+        }
+        else if (!settings.targetSrs.isEmpty())
+        {
+            QString error;
+            std::unique_ptr<WarpStage> warp = WarpStage::create(outputGrid(poDataset), settings.targetSrs, settings.targetResolution, settings.resampling, error);
+            if (!warp)
+            {
+                emit finished(false, error);
+                return false;
+            }
+            RasterGrid grid = warp->outputGrid(outputGrid(poDataset));
+            emit logMessage(QString("Reprojecting to %1: %2 x %3 pixels.").arg(settings.targetSrs).arg(grid.xSize).arg(grid.ySize));
+            stages.push_back(std::move(warp));
+        }
+
+        // Derived bands are computed before resizing so fewer bands are resampled
+        if (!settings.bandExpression.trimmed().isEmpty())
+        {
+            QString error;
+            std::unique_ptr<BandMathStage> bandMath = BandMathStage::create(outputGrid(poDataset), settings.bandExpression, error);
+            if (!bandMath)
+            {
+                emit finished(false, error);
+                return false;
+            }
+            emit logMessage("Computing bands: " + settings.bandExpression.trimmed());
+            stages.push_back(std::move(bandMath));
+        }
+
+        // Resize whatever the previous stages produce
+        RasterGrid grid = outputGrid(poDataset);
+        int width = settings.outputWidth;
+        int height = settings.outputHeight;
+        if (width <= 0 && height <= 0)
+        {
+            width = std::max(1, static_cast<int>(std::lround(grid.xSize * settings.outputScale)));
+            height = std::max(1, static_cast<int>(std::lround(grid.ySize * settings.outputScale)));
+        }
+        else if (width <= 0)
+        {
+            width = std::max(1, static_cast<int>(std::lround(static_cast<double>(grid.xSize) * height / grid.ySize)));
+        }
+        else if (height <= 0)
+        {
+            height = std::max(1, static_cast<int>(std::lround(static_cast<double>(grid.ySize) * width / grid.xSize)));
+        }
+
+        if (tiles && (width != grid.xSize || height != grid.ySize))
+        {
+            emit logMessage("Web tiles use the zoom level resolution; the output size is ignored.");
+        }
+        else if (width != grid.xSize || height != grid.ySize)
+        {
+            emit logMessage(QString("Resizing %1 x %2 to %3 x %4 pixels.").arg(grid.xSize).arg(grid.ySize).arg(width).arg(height));
+            stages.push_back(std::make_unique<ResizeStage>(grid, width, height, settings.resizeResampling));
+        }
+
+        // A shard keeps only its rows of the final grid
+        if (settings.shardCount > 1)
+        {
+            RasterGrid full = outputGrid(poDataset);
+            auto [first, last] = shardRows(full.ySize, settings.shardIndex, settings.shardCount);
+            emit logMessage(QString("Shard %1 of %2: output rows %3 to %4 of %5.")
+                                .arg(settings.shardIndex + 1).arg(settings.shardCount).arg(first).arg(last).arg(full.ySize));
+            stages.push_back(std::make_unique<CropStage>(BlockWindow{0, first, full.xSize, last - first}));
+        }
+
+        return true;
+    }
+
+    // Tiles are cut from a Web Mercator grid at the deepest zoom's resolution,
+    // aligned to its tile matrix
+    bool buildTileGrid(GDALDataset* poDataset)
+    {
+        RasterGrid input = outputGrid(poDataset);
+        QString error;
+        if (settings.maxZoom < 0)
+        {
+            // The first zoom at least as fine as the input
+            std::unique_ptr<WarpStage> probe = WarpStage::create(input, "EPSG:3857", 0.0, settings.resampling, error);
+            if (!probe)
+            {
+                emit finished(false, error);
+                return false;
+            }
+            double nativeResolution = probe->outputGrid(input).geoTransform[1];
+            double zoom = std::ceil(std::log2(TilePyramidSink::resolution(0) / nativeResolution) - 1e-6);
+            settings.maxZoom = static_cast<int>(std::clamp(zoom, 0.0, 24.0));
+        }
+        settings.minZoom = std::clamp(settings.minZoom, 0, settings.maxZoom);
+
+        double resolution = TilePyramidSink::resolution(settings.maxZoom);
+        std::unique_ptr<WarpStage> warp = WarpStage::create(input, "EPSG:3857", resolution, settings.resampling, error);
+        if (!warp)
+        {
+            emit finished(false, error);
+            return false;
+        }
+
+        const double shift = TilePyramidSink::OriginShift;
+        const double world[4] = {-shift, -shift, shift, shift};
+        warp->alignTo(-shift, shift, resolution * TilePyramidSink::TileSize, world);
+        RasterGrid grid = warp->outputGrid(input);
+        emit logMessage(QString("Cutting zoom levels %1-%2 from a %3 x %4 pixel grid.")
+                            .arg(settings.minZoom).arg(settings.maxZoom).arg(grid.xSize).arg(grid.ySize));
+        stages.push_back(std::move(warp));
+        return true;
+    }
+
+    // Grid of the output after all stages
+    RasterGrid outputGrid(GDALDataset* poDataset) const
+    {
+        RasterGrid grid = RasterGrid::fromDataset(poDataset, sourceBands);
+        for (const std::unique_ptr<BlockStage>& stage : stages)
+        {
+            grid = stage->outputGrid(grid);
+        }
+        return grid;
+    }
+
+    GDALDataset* createOutput(const RasterGrid& grid, GDALDriver* poOutDriver, const QString& path, char** papszOptions)
+    {
+        GDALDataset* poOutDataset = createDataset(grid, poOutDriver, path, papszOptions);
+        if (!poOutDataset)
+        {
+            QString errorMsg = "Failed to create output dataset: " + path + "\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+            emit finished(false, errorMsg);
+            return nullptr;
+        }
+        return poOutDataset;
+    }
+
+    bool processWithCreateMethod(GDALDataset* poDataset, GDALDriver* poOutDriver, char** papszOptions)
+    {
+        emit logMessage("Using Create method.");
+
+        // Get input dataset dimensions and properties
+        int nBands = poDataset->GetRasterCount();
+        if (nBands == 0)
+        {
+            QString errorMsg = "Input dataset has no raster bands.";
+            emit finished(false, errorMsg);
+            return false;
+        }
+
+        // An incremental job reuses the existing output when the last run
+        // was the same job; otherwise the output is created from scratch
+        RasterGrid grid = outputGrid(poDataset);
+        GDALDataset* poOutDataset = nullptr;
+        if (settings.incremental)
+        {
+            manifest = std::make_unique<WindowManifest>(outputFile + ".manifest");
+            if (manifest->storedSignature().startsWith(jobSignature() + '|'))
+                poOutDataset = openExistingOutput(grid);
+            manifestReuse = poOutDataset != nullptr;
+            emit logMessage(manifestReuse ? "Incremental: updating the existing output." : "Incremental: no matching previous run, writing everything.");
+        }
+
+        if (!poOutDataset)
+            poOutDataset = createOutput(grid, poOutDriver, outputFile, papszOptions);
+        if (!poOutDataset)
+        {
+            manifest.reset();
+            return false;
+        }
+
+        // Processing and writing data
+        bool ok = processData(poDataset, poOutDataset);
+        GDALClose(poOutDataset);
+        manifest.reset();
+        return ok;
+    }
+
+    // Opens the output for update if it has the layout this job produces
+    GDALDataset* openExistingOutput(const RasterGrid& grid)
+    {
+        if (!QFileInfo::exists(outputFile))
+            return nullptr;
+
+        GDALDataset* poOutDataset = static_cast<GDALDataset*>(GDALOpenEx(outputFile.toStdString().c_str(), GDAL_OF_RASTER | GDAL_OF_UPDATE, nullptr, nullptr, nullptr));
+        if (!poOutDataset)
+            return nullptr;
+
+        bool matches = poOutDataset->GetDriver() && outputDriverName == poOutDataset->GetDriver()->GetDescription() &&
+                       poOutDataset->GetRasterXSize() == grid.xSize && poOutDataset->GetRasterYSize() == grid.ySize &&
+                       poOutDataset->GetRasterCount() == static_cast<int>(grid.bandTypes.size());
+        for (int b = 0; matches && b < poOutDataset->GetRasterCount(); ++b)
+            matches = poOutDataset->GetRasterBand(b + 1)->GetRasterDataType() == grid.bandTypes[b];
+
+        if (!matches)
+        {
+            GDALClose(poOutDataset);
+            return nullptr;
+        }
+        return poOutDataset;
+    }
+
+    // Everything apart from the input pixels that shapes the output.
+    // Without the file part (input path, shard) it describes the kind of
+    // job instead, for caches that carry over between files
+    QByteArray jobSignature(bool withFile = true) const
+    {
+        QStringList parts;
+        if (withFile)
+            parts << inputFile;
+        parts << outputDriverName;
+        for (auto it = gdalOptions.begin(); it != gdalOptions.end(); ++it)
+            parts << it.key() + "=" + it.value();
+        parts << settings.targetSrs << QString::number(settings.targetResolution, 'g', 17)
+              << QString::number(static_cast<int>(settings.resampling))
+              << QString::number(settings.outputScale, 'g', 17) << QString::number(settings.outputWidth) << QString::number(settings.outputHeight)
+              << QString::number(static_cast<int>(settings.resizeResampling))
+              << settings.bandExpression.trimmed() << settings.bandSelection.trimmed()
+              << QString::number(static_cast<int>(settings.subsetMode)) << settings.subset.trimmed();
+        if (withFile)
+            parts << QString("%1/%2").arg(settings.shardIndex).arg(settings.shardCount);
+        else
+            parts << QString::number(settings.mosaicInputs.size()) << QString::number(static_cast<int>(settings.compositeRule));
+        return QCryptographicHash::hash(parts.join("\n").toUtf8(), QCryptographicHash::Sha1).toHex();
+    }
+
+    bool processWithCreateCopyMethod(GDALDataset* poDataset, GDALDriver* poOutDriver, char** papszOptions)
+    {
+        emit logMessage("Using CreateCopy method.");
+
+        // CreateCopy needs a complete source, so when stages or a band
+        // selection change the data it is staged in a temporary tiled GTiff first
+        GDALDataset* poSource = poDataset;
+        GDALDriver* poStagingDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+        QString stagingFile = outputFile + ".staging.tif";
+        if (!stages.empty() || subsetsBands(poDataset))
+        {
+            if (!poStagingDriver)
+            {
+                emit finished(false, "The GTiff driver is required to stage processed data for " + outputDriverName + ".");
+                return false;
+            }
+
+            emit logMessage("Staging processed data in " + stagingFile);
+
+            char** papszStagingOptions = CSLSetNameValue(nullptr, "TILED", "YES");
+            papszStagingOptions = CSLSetNameValue(papszStagingOptions, "BIGTIFF", "IF_SAFER");
+            poSource = createOutput(outputGrid(poDataset), poStagingDriver, stagingFile, papszStagingOptions);
+            CSLDestroy(papszStagingOptions);
+            if (!poSource)
+            {
+                return false;
+            }
+
+            if (!processData(poDataset, poSource))
+            {
+                GDALClose(poSource);
+                poStagingDriver->Delete(stagingFile.toStdString().c_str());
+                return false;
+            }
+        }
+
+        // Copy the dataset directly
+        GDALDataset* poOutDataset = poOutDriver->CreateCopy(
+            outputFile.toStdString().c_str(),
+            poSource,
+            FALSE, // Synchronous copy
+            papszOptions,
+            progressCallback,
+            this);
+
+        if (poSource != poDataset)
+        {
+            GDALClose(poSource);
+            poStagingDriver->Delete(stagingFile.toStdString().c_str());
+        }
+
+        if (!poOutDataset && !isConverting.load())
+        {
+            finishCancelled();
+            return false;
+        }
+
+        if (!poOutDataset)
+        {
+            QString errorMsg = "Failed to create output dataset using CreateCopy: " + outputFile + "\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+            emit finished(false, errorMsg);
+            return false;
+        }
+
+        // Close the output dataset
+        GDALClose(poOutDataset);
+
+        return true;
+    }
+
+    bool processData(GDALDataset* poDataset, GDALDataset* poOutDataset)
+    {
+        DatasetSink sink(poOutDataset, &isConverting);
+        openFastReaders(poDataset);
+        bool ok = processBlocks(poDataset, poOutDataset->GetRasterXSize(), poOutDataset->GetRasterYSize(), sink);
+        closeFastReaders();
+        return ok;
+    }
+
+    bool splitsOutput() const
+    {
+        return settings.splitChunkSize > 0 || settings.splitColumns > 1 || settings.splitRows > 1;
+    }
+
+    // Writes the output as a grid of <name>_<row>_<col> files from one pass over the input
+    bool processSplit(GDALDataset* poDataset, GDALDriver* poOutDriver, char** papszOptions, bool bCreateSupported)
+    {
+        if (!bCreateSupported && poOutDriver->GetMetadataItem(GDAL_DCAP_CREATECOPY) == nullptr)
+        {
+            emit finished(false, "Output driver does not support Create or CreateCopy methods.");
+            return false;
+        }
+
+        RasterGrid grid = outputGrid(poDataset);
+        if (grid.bandTypes.empty())
+        {
+            emit finished(false, "Input dataset has no raster bands.");
+            return false;
+        }
+
+        int partWidth = settings.splitChunkSize > 0 ? settings.splitChunkSize : (grid.xSize + settings.splitColumns - 1) / settings.splitColumns;
+        int partHeight = settings.splitChunkSize > 0 ? settings.splitChunkSize : (grid.ySize + settings.splitRows - 1) / settings.splitRows;
+        partWidth = std::max(1, partWidth);
+        partHeight = std::max(1, partHeight);
+        int columns = (grid.xSize + partWidth - 1) / partWidth;
+        int rows = (grid.ySize + partHeight - 1) / partHeight;
+        emit logMessage(QString("Splitting the output into %1 x %2 files of up to %3 x %4 pixels.").arg(columns).arg(rows).arg(partWidth).arg(partHeight));
+
+        // CreateCopy-only drivers get each part staged as a tiled GTiff
+        GDALDriver* poPartDriver = bCreateSupported ? poOutDriver : GetGDALDriverManager()->GetDriverByName("GTiff");
+        if (!poPartDriver)
+        {
+            emit finished(false, "The GTiff driver is required to stage processed data for " + outputDriverName + ".");
+            return false;
+        }
+        char** papszPartOptions = bCreateSupported ? CSLDuplicate(papszOptions) : nullptr;
+        if (!bCreateSupported)
+        {
+            papszPartOptions = CSLSetNameValue(papszPartOptions, "TILED", "YES");
+            papszPartOptions = CSLSetNameValue(papszPartOptions, "BIGTIFF", "IF_SAFER");
+        }
+
+        QFileInfo info(outputFile);
+        QDir folder(info.absolutePath());
+        QString suffix = info.suffix().isEmpty() ? QString() : "." + info.suffix();
+        std::vector<SplitSink::Part> parts;
+        for (int row = 0; row < rows; ++row)
+        {
+            for (int column = 0; column < columns; ++column)
+            {
+                SplitSink::Part part;
+                part.area = {column * partWidth, row * partHeight,
+                             std::min(partWidth, grid.xSize - column * partWidth), std::min(partHeight, grid.ySize - row * partHeight)};
+                part.path = folder.filePath(QString("%1_%2_%3%4").arg(info.completeBaseName()).arg(row).arg(column).arg(suffix));
+                if (!bCreateSupported)
+                    part.stagingPath = part.path + ".staging.tif";
+                part.grid = CropStage(part.area).outputGrid(grid);
+                parts.push_back(std::move(part));
+            }
+        }
+
+        // Pieces may still point into mapped input until the sink is gone
+        openFastReaders(poDataset);
+        bool ok = false;
+        {
+            SplitSink sink(std::move(parts), poPartDriver, papszPartOptions, bCreateSupported ? nullptr : poOutDriver, papszOptions,
+                           numCores, &isConverting);
+            ok = processBlocks(poDataset, grid.xSize, grid.ySize, sink);
+        }
+        closeFastReaders();
+        CSLDestroy(papszPartOptions);
+        return ok;
+    }
+
+    bool processTiles(GDALDataset* poDataset)
+    {
+        emit logMessage(QString("Writing %1 %2 tiles to %3").arg(settings.tileMode == ConversionSettings::TmsTiles ? "TMS" : "XYZ")
+                            .arg(settings.tileFormat).arg(outputFile));
+
+        if (!GetGDALDriverManager()->GetDriverByName(settings.tileFormat.toStdString().c_str()) ||
+            !GetGDALDriverManager()->GetDriverByName("MEM"))
+        {
+            emit finished(false, "The " + settings.tileFormat + " and MEM drivers are required to write tiles.");
+            return false;
+        }
+        if (!QDir().mkpath(outputFile))
+        {
+            emit finished(false, "Cannot create the tile folder: " + outputFile);
+            return false;
+        }
+
+        RasterGrid grid = outputGrid(poDataset);
+        TilePyramidSink sink(grid, outputFile, settings.tileFormat,
+                             settings.tileMode == ConversionSettings::TmsTiles ? TilePyramidSink::TMS : TilePyramidSink::XYZ,
+                             settings.minZoom, settings.maxZoom, numCores, &isConverting);
+        openFastReaders(poDataset);
+        bool ok = processBlocks(poDataset, grid.xSize, grid.ySize, sink);
+        closeFastReaders();
+        return ok;
+    }
+
+    bool isMosaic() const { return settings.mosaicInputs.size() > 1; }
+
+    // Sets up the optional read paths that bypass RasterIO's copy
+    void openFastReaders(GDALDataset* poDataset)
+    {
+        // A mosaic reads its sources itself
+        if (isMosaic())
+            return;
+
+        if (settings.memoryMapInput)
+        {
+            mappedInput = MappedInput::create(poDataset, sourceBands);
+            if (mappedInput)
+            {
+                emit logMessage("Reading input in place from a memory-mapped file.");
+                return;
+            }
+            emit logMessage("Input layout cannot be memory-mapped (needs an uncompressed native-order file), using copies.");
+        }
+
+#ifdef HAVE_IO_URING
+        if (settings.useIoUring)
+        {
+            if (UringTileReader::supports(poDataset, inputFile))
+            {
+                tileReader = std::make_unique<UringTileReader>(poDataset, inputFile, sourceBands);
+                if (tileReader->isValid())
+                {
+                    emit logMessage(QString("Reading blocks with io_uring (queue depth %1).").arg(UringTileReader::queueDepth));
+                }
+                else
+                {
+                    emit logMessage("io_uring unavailable, falling back to GDAL reads.");
+                    tileReader.reset();
+                }
+            }
+            else
+            {
+                emit logMessage("io_uring reader needs an uncompressed little-endian GTiff input, using GDAL reads.");
+            }
+        }
+#endif
+    }
+
+    // Mappings must be released before the input dataset is closed
+    void closeFastReaders()
+    {
+        mappedInput.reset();
+#ifdef HAVE_IO_URING
+        tileReader.reset();
+#endif
+    }
+
+    // Windows are planned on the nXSize x nYSize output grid
+    bool processBlocks(GDALDataset* poDataset, int nXSize, int nYSize, BlockSink& sink)
+    {
+        int blockSizeX = settings.blockSize;
+        int blockSizeY = settings.blockSize;
+
+        if (settings.autotune)
+        {
+            autotune(poDataset, nXSize, nYSize, blockSizeX, blockSizeY);
+        }
+
+        // Align windows to the output block layout so every write hands
+        // complete tiles/strips to the encoder instead of partial ones
+        int nOutBlockX = 0;
+        int nOutBlockY = 0;
+        sink.blockAlignment(nOutBlockX, nOutBlockY);
+        if (nOutBlockX > 0 && nOutBlockY > 0)
+        {
+            if (nOutBlockX >= nXSize)
+            {
+                // Striped output: write whole strips, keeping roughly the
+                // same number of pixels per window
+                int nRows = std::max(1, (blockSizeX * blockSizeY) / nXSize);
+                blockSizeX = nXSize;
+                blockSizeY = std::max(1, nRows / nOutBlockY) * nOutBlockY;
+            }
+            else
+            {
+                blockSizeX = std::max(1, blockSizeX / nOutBlockX) * nOutBlockX;
+                blockSizeY = std::max(1, blockSizeY / nOutBlockY) * nOutBlockY;
+            }
+        }
+
+        std::vector<BlockWindow> windows = planWindows(nXSize, nYSize, blockSizeX, blockSizeY);
+        int totalBlocks = static_cast<int>(windows.size());
+        int blocksCompleted = 0;
+        int blocksSkipped = 0;
+
+        // Hashes are only comparable for the same window layout
+        if (manifest)
+        {
+            QByteArray layout = QString("%1x%2/%3x%4").arg(nXSize).arg(nYSize).arg(blockSizeX).arg(blockSizeY).toUtf8();
+            manifest->begin(jobSignature() + '|' + layout, windows.size(), manifestReuse);
+        }
+
+        // Work out every window's stage chain up front so the prefetcher
+        // sees the input windows that will actually be read
+        std::vector<BlockBuffer> plans(totalBlocks);
+        std::vector<BlockWindow> readWindows(totalBlocks);
+        for (int i = 0; i < totalBlocks; ++i)
+        {
+            prepareBlock(plans[i], windows[i]);
+            readWindows[i] = plans[i].window;
+        }
+
+        // Visit the windows in the order that keeps input blocks cached
+        // until their neighbours need them; order[i] is the row-major index
+        // of the i-th window visited, which the manifest keeps using
+        std::vector<int> order = planTraversal(poDataset, nXSize, blockSizeX, readWindows);
+        {
+            std::vector<BlockBuffer> ordered(totalBlocks);
+            for (int i = 0; i < totalBlocks; ++i)
+            {
+                ordered[i] = std::move(plans[order[i]]);
+                readWindows[i] = ordered[i].window;
+            }
+            plans = std::move(ordered);
+        }
+
+        // Thread pool; a shared one stays warm between jobs, so batches are
+        // awaited through a semaphore rather than waitForDone()
+        QThreadPool ownPool;
+        ownPool.setMaxThreadCount(numCores);
+        QThreadPool& threadPool = sharedPool ? *sharedPool : ownPool;
+        QSemaphore batchDone;
+
+        // Node-local placement needs pools of its own and buffers it owns
+        std::unique_ptr<NumaPlacement> numa;
+        std::vector<GDALDataType> sourceTypes;
+        if (settings.numaAware && !sharedPool && !mappedInput && !isMosaic())
+        {
+            numa = NumaPlacement::create(numCores);
+            for (int bandIndex : sourceBands)
+                sourceTypes.push_back(poDataset->GetRasterBand(bandIndex)->GetRasterDataType());
+            emit logMessage(numa ? "NUMA placement: " + numa->describe() + "." : QString("NUMA placement: single node, not needed."));
+        }
+
+        // Process blocks
+        emit logMessage(QString("Starting block processing using %1 core(s), %2x%3 windows...")
+                            .arg(numCores).arg(blockSizeX).arg(blockSizeY));
+
+        ReadAheadPrefetcher prefetcher(poDataset, inputFile, sourceBands, settings.prefetchDistance);
+        if (settings.prefetchDistance > 0)
+        {
+            emit logMessage(QString("Read-ahead enabled, %1 window(s) ahead.").arg(settings.prefetchDistance));
+        }
+
+        // Windows are handled in batches of one per core: the batch is read
+        // in this thread, processed in parallel and written back in order
+        std::vector<BlockBuffer> batch;
+        std::vector<char> unchanged;
+        for (int first = 0, nBatch = 0; first < totalBlocks && isConverting.load(); first += nBatch)
+        {
+            // A quota can shrink the batch, or pause the job here while
+            // higher-priority jobs have the pool
+            int batchLimit = windowQuota ? windowQuota->acquire(isConverting) : numCores;
+            if (batchLimit == 0)
+                break;
+
+            nBatch = std::min(batchLimit, totalBlocks - first);
+            if (numa)
+                numa->prepare(batch, plans, first, nBatch, sourceTypes);
+            else
+                batch.assign(nBatch, BlockBuffer());
+            unchanged.assign(nBatch, 0);
+            int pending = 0;
+
+            // Hint the windows after this batch; its own reads start now,
+            // so a hint for them could only arrive late
+            prefetcher.advise(readWindows, first + nBatch);
+
+            for (int i = 0; i < nBatch; ++i)
+            {
+                // Read data in the main thread
+                if (!numa)
+                    batch[i] = std::move(plans[first + i]);
+                if (!readBlock(poDataset, batch[i]))
+                {
+                    batchDone.acquire(pending);
+                    pending = 0;
+                    if (!isConverting.load())
+                        break; // the read was aborted by the cancel
+                    QString errorMsg = "Failed to read data from input dataset.\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+                    emit finished(false, errorMsg);
+                    return false;
+                }
+
+                // The output window is already right when its input is unchanged
+                if (manifest && manifest->unchanged(order[first + i], WindowManifest::hash(batch[i])))
+                {
+                    unchanged[i] = 1;
+                    ++blocksSkipped;
+                    continue;
+                }
+
+                // Process data in worker threads while the rest of the batch is read
+                if (numa)
+                    numa->start(i, batch[i], stages, *backend, &isConverting, &batchDone);
+                else
+                    threadPool.start(new BlockProcessor(batch[i], stages, *backend, &isConverting, &batchDone));
+                ++pending;
+            }
+
+            // Wait for the batch to complete
+            batchDone.acquire(pending);
+
+            if (!isConverting.load())
+                break;
+
+            for (const std::unique_ptr<BlockStage>& stage : stages)
+            {
+                QString failure = stage->failure();
+                if (!failure.isEmpty())
+                {
+                    emit finished(false, failure);
+                    return false;
+                }
+            }
+
+            // Write data back to the output in the main thread
+            for (int i = 0; i < nBatch; ++i)
+            {
+                if (unchanged[i])
+                    continue;
+
+                if (!sink.write(batch[i]))
+                {
+                    if (!isConverting.load())
+                        break;
+                    QString errorMsg = "Failed to write data to output.\nGDAL Error: " + QString(CPLGetLastErrorMsg());
+                    emit finished(false, errorMsg);
+                    return false;
+                }
+            }
+
+            // Update progress
+            blocksCompleted += nBatch;
+            float progress = static_cast<float>(blocksCompleted) / totalBlocks;
+            emit progressUpdated(progress);
+        }
+
+        // A cancelled job skips the final copies of a split output
+        if (!isConverting.load())
+        {
+            finishCancelled();
+            return false;
+        }
+
+        bool finishedWriting = sink.finish();
+        if (!isConverting.load())
+        {
+            // Cancelled while the copies ran
+            finishCancelled();
+            return false;
+        }
+
+        if (!finishedWriting)
+        {
+            emit finished(false, "Failed to finish writing the output.\nGDAL Error: " + QString(CPLGetLastErrorMsg()));
+            return false;
+        }
+
+        if (manifest)
+        {
+            emit logMessage(QString("Incremental: %1 of %2 window(s) unchanged and skipped.").arg(blocksSkipped).arg(totalBlocks));
+            if (!manifest->save())
+                emit logMessage("Could not save the window manifest; the next run will rewrite everything.");
+        }
+
+        // Final progress update
+        emit progressUpdated(1.0f);
+
+        return true;
+    }
+
+    // Picks the traversal for the row-major windows whose input windows
+    // are readWindows and returns it as a permutation. Auto replays each
+    // order against an LRU model of the block cache (half of GDAL_CACHEMAX,
+    // the rest is left to the output) and keeps row-major unless another
+    // order saves at least a tenth of the block decodes. Inputs that do not
+    // go through the block cache stay row-major under Auto
+    std::vector<int> planTraversal(GDALDataset* poDataset, int nXSize, int blockSizeX, const std::vector<BlockWindow>& readWindows)
+    {
+        static const char* const names[] = {"auto", "row-major", "tile-row-major", "Morton", "Hilbert"};
+        int nCols = (nXSize + blockSizeX - 1) / blockSizeX;
+        int count = static_cast<int>(readWindows.size());
+        std::vector<int> rowMajor(count);
+        std::iota(rowMajor.begin(), rowMajor.end(), 0);
+
+        bool cached = !mappedInput && !isMosaic();
+#ifdef HAVE_IO_URING
+        cached = cached && !tileReader;
+#endif
+        // A single column of windows (e.g. striped output) is visited top to
+        // bottom whatever the order
+        TraversalOrder requested = settings.traversal;
+        if (nCols <= 1 || count <= 2 || (requested == TraversalOrder::Auto && !cached))
+            return rowMajor;
+
+        int nBlockX = 0;
+        int nBlockY = 0;
+        poDataset->GetRasterBand(sourceBands.front())->GetBlockSize(&nBlockX, &nBlockY);
+        nBlockX = std::max(1, nBlockX);
+        nBlockY = std::max(1, nBlockY);
+
+        if (requested != TraversalOrder::Auto)
+        {
+            emit logMessage(QString("Traversal: %1.").arg(names[static_cast<int>(requested)]));
+            return traversalOrder(requested, readWindows, nCols, nBlockX, nBlockY);
+        }
+
+        // The replay costs a hash lookup per block touched, so very large
+        // plans skip it rather than delay the start
+        if (count > (1 << 20))
+            return rowMajor;
+
+        qint64 blockBytes = static_cast<qint64>(nBlockX) * nBlockY;
+        qint64 pixelBytes = 0;
+        for (int bandIndex : sourceBands)
+            pixelBytes += GDALGetDataTypeSizeBytes(poDataset->GetRasterBand(bandIndex)->GetRasterDataType());
+        qint64 capacity = std::max<qint64>(1, GDALGetCacheMax64() / 2 / std::max<qint64>(1, blockBytes * pixelBytes));
+
+        qint64 rowMajorDecodes = simulateDecodes(rowMajor, readWindows, nBlockX, nBlockY, capacity);
+        TraversalOrder best = TraversalOrder::RowMajor;
+        qint64 bestDecodes = rowMajorDecodes;
+        std::vector<int> bestOrder = rowMajor;
+        for (TraversalOrder candidate : {TraversalOrder::TileRowMajor, TraversalOrder::Hilbert, TraversalOrder::Morton})
+        {
+            std::vector<int> candidateOrder = traversalOrder(candidate, readWindows, nCols, nBlockX, nBlockY);
+            qint64 decodes = simulateDecodes(candidateOrder, readWindows, nBlockX, nBlockY, capacity);
+            if (decodes < bestDecodes && decodes * 10 <= rowMajorDecodes * 9)
+            {
+                best = candidate;
+                bestDecodes = decodes;
+                bestOrder = std::move(candidateOrder);
+            }
+        }
+
+        emit logMessage(QString("Traversal: %1 (auto), about %2 input block decodes against %3 row-major, %4-block cache.")
+                            .arg(names[static_cast<int>(best)]).arg(bestDecodes).arg(rowMajorDecodes).arg(capacity));
+        return bestOrder;
+    }
+
+    // Permutation of the row-major windows for one traversal order. Curve
+    // orders index the nCols-wide window grid; tile-row-major visits input
+    // blocks row-major and, within each, the windows whose input starts there
+    static std::vector<int> traversalOrder(TraversalOrder traversal, const std::vector<BlockWindow>& readWindows, int nCols, int nBlockX, int nBlockY)
+    {
+        int count = static_cast<int>(readWindows.size());
+        int nRows = (count + nCols - 1) / nCols;
+        std::vector<quint64> keys(count);
+        quint32 side = std::bit_ceil(static_cast<quint32>(std::max(nCols, nRows)));
+        for (int i = 0; i < count; ++i)
+        {
+            quint32 col = i % nCols;
+            quint32 row = i / nCols;
+            switch (traversal)
+            {
+            case TraversalOrder::TileRowMajor:
+            {
+                const BlockWindow& w = readWindows[i];
+                quint64 blockRow = static_cast<quint64>(std::max(0, w.y) / nBlockY);
+                quint64 blockCol = static_cast<quint64>(std::max(0, w.x) / nBlockX);
+                keys[i] = (blockRow << 32) | blockCol; // the stable sort keeps ties row-major
+                break;
+            }
+            case TraversalOrder::Morton:
+                keys[i] = mortonKey(col, row);
+                break;
+            case TraversalOrder::Hilbert:
+                keys[i] = hilbertKey(side, col, row);
+                break;
+            default:
+                keys[i] = static_cast<quint64>(i);
+                break;
+            }
+        }
+
+        std::vector<int> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+        return order;
+    }
+
+    static quint64 mortonKey(quint32 x, quint32 y)
+    {
+        quint64 key = 0;
+        for (int bit = 0; bit < 32; ++bit)
+            key |= (static_cast<quint64>((x >> bit) & 1) << (2 * bit)) | (static_cast<quint64>((y >> bit) & 1) << (2 * bit + 1));
+        return key;
+    }
+
+    // Distance of (x, y) along the Hilbert curve filling a side x side grid
+    static quint64 hilbertKey(quint32 side, quint32 x, quint32 y)
+    {
+        quint64 key = 0;
+        for (quint32 s = side / 2; s > 0; s /= 2)
+        {
+            quint32 rx = (x & s) ? 1 : 0;
+            quint32 ry = (y & s) ? 1 : 0;
+            key += static_cast<quint64>(s) * s * ((3 * rx) ^ ry);
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = side - 1 - x;
+                    y = side - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return key;
+    }
+
+    // Input blocks decoded when the windows are read in the given order
+    // through an LRU cache holding capacity blocks
+    static qint64 simulateDecodes(const std::vector<int>& order, const std::vector<BlockWindow>& readWindows, int nBlockX, int nBlockY, qint64 capacity)
+    {
+        std::list<quint64> lru;
+        std::unordered_map<quint64, std::list<quint64>::iterator> cached;
+        qint64 decodes = 0;
+        for (int index : order)
+        {
+            const BlockWindow& w = readWindows[index];
+            if (w.width <= 0 || w.height <= 0)
+                continue;
+
+            for (int by = std::max(0, w.y) / nBlockY; by <= (w.y + w.height - 1) / nBlockY; ++by)
+            {
+                for (int bx = std::max(0, w.x) / nBlockX; bx <= (w.x + w.width - 1) / nBlockX; ++bx)
+                {
+                    quint64 block = (static_cast<quint64>(by) << 32) | static_cast<quint32>(bx);
+                    auto it = cached.find(block);
+                    if (it != cached.end())
+                    {
+                        lru.splice(lru.begin(), lru, it->second);
+                        continue;
+                    }
+
+                    ++decodes;
+                    lru.push_front(block);
+                    cached[block] = lru.begin();
+                    if (static_cast<qint64>(lru.size()) > capacity)
+                    {
+                        cached.erase(lru.back());
+                        lru.pop_back();
+                    }
+                }
+            }
+        }
+        return decodes;
+    }
+
+    static std::vector<BlockWindow> planWindows(int nXSize, int nYSize, int blockSizeX, int blockSizeY)
+    {
+        std::vector<BlockWindow> windows;
+        for (int y = 0; y < nYSize; y += blockSizeY)
+        {
+            for (int x = 0; x < nXSize; x += blockSizeX)
+            {
+                windows.push_back({x, y, std::min(blockSizeX, nXSize - x), std::min(blockSizeY, nYSize - y)});
+            }
+        }
+        return windows;
+    }
+
+    // Sets the window each stage produces and, from that, the window to read
+    void prepareBlock(BlockBuffer& buffer, const BlockWindow& target)
+    {
+        buffer.stageWindows.assign(stages.size(), target);
+        BlockWindow window = target;
+        for (size_t i = stages.size(); i-- > 0;)
+        {
+            buffer.stageWindows[i] = window;
+            window = stages[i]->inputWindow(window);
+        }
+        buffer.window = window;
+    }
+
+    // Reports the cancel with how long the pipeline took to stop
+    void finishCancelled()
+    {
+        qint64 latency = cancelLatencyMs();
+        if (latency < 0)
+        {
+            emit finished(false, "Conversion cancelled by user.");
+            return;
+        }
+        if (latency > CancelLatencyTargetMs)
+            emit logMessage(QString("Cancellation took %1 ms, over the %2 ms target.").arg(latency).arg(CancelLatencyTargetMs));
+        emit finished(false, QString("Conversion cancelled by user; stopped %1 ms after the request.").arg(latency));
+    }
+
+    bool readBlock(GDALDataset* poDataset, BlockBuffer& buffer)
+    {
+        // Nothing to read when no input pixel contributes to the window
+        if (buffer.window.width <= 0 || buffer.window.height <= 0)
+        {
+            buffer.bandData.assign(sourceBands.size(), std::vector<char>());
+            buffer.bandTypes.clear();
+            for (int bandIndex : sourceBands)
+            {
+                buffer.bandTypes.push_back(poDataset->GetRasterBand(bandIndex)->GetRasterDataType());
+            }
+            return true;
+        }
+
+        if (mappedInput)
+        {
+            mappedInput->view(buffer);
+            return true;
+        }
+
+#ifdef HAVE_IO_URING
+        if (tileReader)
+            return tileReader->read(buffer);
+#endif
+
+        // Unselected bands are never touched
+        const BlockWindow& w = buffer.window;
+        int nBands = static_cast<int>(sourceBands.size());
+        buffer.bandData.resize(nBands);
+        buffer.bandTypes.resize(nBands);
+
+        for (int b = 0; b < nBands; ++b)
+        {
+            GDALRasterBand* poBand = poDataset->GetRasterBand(sourceBands[b]);
+            GDALDataType eType = poBand->GetRasterDataType();
+            buffer.bandTypes[b] = eType;
+            buffer.bandData[b].resize(static_cast<size_t>(GDALGetDataTypeSizeBytes(eType)) * w.width * w.height);
+
+            GDALRasterIOExtraArg extraArg = cancellableIO(&isConverting);
+            CPLErr err = poBand->RasterIO(GF_Read, w.x, w.y, w.width, w.height, buffer.bandData[b].data(), w.width, w.height, eType, 0, 0, &extraArg);
+            if (err != CE_None)
+                return false;
+        }
+        return true;
+    }
+
+    // Picks the window size and thread count for this job, either from the
+    // cache or by timing short probes on a sample of windows
+    void autotune(GDALDataset* poDataset, int nXSize, int nYSize, int& blockSizeX, int& blockSizeY)
+    {
+        // Probing a raster that fits in a few probes costs more than it saves
+        const qint64 probePixels = qint64(1) << 21;
+        if (qint64(nXSize) * nYSize < 16 * probePixels)
+        {
+            emit logMessage("Autotune: input too small to benefit, using defaults.");
+            return;
+        }
+
+        // Storage tiers matter, so both the input and output locations are
+        // part of the key, and so is the stage chain: a choice probed on a
+        // plain copy says little about a compute-bound reprojection
+        QString keyText = QString("%1|%2|%3|%4|%5|%6")
+                              .arg(outputDriverName)
+                              .arg(GDALGetDataTypeName(poDataset->GetRasterBand(1)->GetRasterDataType()))
+                              .arg(gdalOptions.value("COMPRESS", "NONE").toUpper())
+                              .arg(QFileInfo(inputFile).absolutePath())
+                              .arg(QFileInfo(outputFile).absolutePath())
+                              .arg(QString::fromLatin1(jobSignature(false)));
+        QString key = QString::fromLatin1(QCryptographicHash::hash(keyText.toUtf8(), QCryptographicHash::Sha1).toHex());
+
+        QSettings cache;
+        cache.beginGroup("Autotune");
+        if (cache.contains(key + "/blockSize"))
+        {
+            blockSizeX = blockSizeY = cache.value(key + "/blockSize").toInt();
+            numCores = std::clamp(cache.value(key + "/threads").toInt(), 1, numCores);
+            emit logMessage(QString("Autotune: using cached %1x%1 windows with %2 thread(s).").arg(blockSizeX).arg(numCores));
+            return;
+        }
+
+        emit logMessage("Autotune: probing window sizes and thread counts...");
+
+        std::vector<int> threadCandidates = {1};
+        if (numCores / 2 > 1)
+            threadCandidates.push_back(numCores / 2);
+        if (numCores > 1)
+            threadCandidates.push_back(numCores);
+
+        int bestBlockSize = blockSizeX;
+        int bestThreads = numCores;
+        double bestThroughput = 0.0;
+        int probeIndex = 0;
+
+        for (int blockSize : {128, 256, 512, 1024, 2048})
+        {
+            if (blockSize > std::max(nXSize, nYSize))
+                break;
+
+            for (int threads : threadCandidates)
+            {
+                if (!isConverting.load())
+                    return;
+
+                // Each probe samples different windows so the block cache
+                // warmed by earlier probes does not skew the comparison
+                double throughput = probeThroughput(poDataset, nXSize, nYSize, blockSize, threads, probePixels, probeIndex++);
+                emit logMessage(QString("Autotune: %1x%1, %2 thread(s): %3 Mpixel/s")
+                                    .arg(blockSize).arg(threads).arg(throughput / 1e6, 0, 'f', 1));
+                if (throughput > bestThroughput)
+                {
+                    bestThroughput = throughput;
+                    bestBlockSize = blockSize;
+                    bestThreads = threads;
+                }
+            }
+        }
+
+        if (bestThroughput <= 0.0)
+        {
+            emit logMessage("Autotune: probes failed, using defaults.");
+            return;
+        }
+
+        blockSizeX = blockSizeY = bestBlockSize;
+        numCores = bestThreads;
+
+        cache.setValue(key + "/description", keyText);
+        cache.setValue(key + "/blockSize", bestBlockSize);
+        cache.setValue(key + "/threads", bestThreads);
+
+        emit logMessage(QString("Autotune: selected %1x%1 windows with %2 thread(s).").arg(bestBlockSize).arg(bestThreads));
+    }
+
+    // Sparse in-memory GTiff the probes write to, so encoding is timed too.
+    // GTiff and COG output keep the job's options (compression included)
+    // and encode with the probed thread count
+    GDALDataset* createProbeOutput(GDALDataset* poDataset, const QString& path, int threads)
+    {
+        GDALDriver* poDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+        if (!poDriver)
+            return nullptr;
+
+        char** papszOptions = CSLSetNameValue(nullptr, "TILED", "YES");
+        if (outputDriverName == "GTiff" || outputDriverName == "COG")
+        {
+            for (auto it = gdalOptions.begin(); it != gdalOptions.end(); ++it)
+                papszOptions = CSLSetNameValue(papszOptions, it.key().toStdString().c_str(), it.value().toStdString().c_str());
+            const char* compress = CSLFetchNameValue(papszOptions, "COMPRESS");
+            if (compress && !EQUAL(compress, "NONE") && !gdalOptions.contains("NUM_THREADS"))
+                papszOptions = CSLSetNameValue(papszOptions, "NUM_THREADS", QString::number(threads).toStdString().c_str());
+        }
+
+        RasterGrid grid = outputGrid(poDataset);
+        GDALDataset* poProbe = poDriver->Create(path.toStdString().c_str(), grid.xSize, grid.ySize, static_cast<int>(grid.bandTypes.size()),
+                                                grid.bandTypes[0], papszOptions);
+        CSLDestroy(papszOptions);
+        return poProbe;
+    }
+
+    // Returns pixels per second for reading, processing and writing a sample of windows
+    double probeThroughput(GDALDataset* poDataset, int nXSize, int nYSize, int blockSize, int threads, qint64 probePixels, int sampleOffset)
+    {
+        std::vector<BlockWindow> windows = planWindows(nXSize, nYSize, blockSize, blockSize);
+        int nWindows = static_cast<int>(windows.size());
+        int nSamples = static_cast<int>(std::clamp<qint64>(probePixels / (qint64(blockSize) * blockSize), 2, nWindows));
+        int stride = std::max(1, nWindows / nSamples);
+
+        QString probePath = QString("/vsimem/autotune_probe_%1.tif").arg(reinterpret_cast<quintptr>(this));
+        GDALDataset* poProbe = createProbeOutput(poDataset, probePath, threads);
+        if (!poProbe)
+            return 0.0;
+        auto discardProbe = [&]() {
+            GDALClose(poProbe);
+            VSIUnlink(probePath.toStdString().c_str());
+        };
+        DatasetSink sink(poProbe, &isConverting);
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(threads);
+
+        qint64 pixels = 0;
+        QElapsedTimer probeTimer;
+        probeTimer.start();
+
+        std::vector<BlockBuffer> batch;
+        for (int first = 0; first < nSamples && isConverting.load(); first += threads)
+        {
+            int nBatch = std::min(threads, nSamples - first);
+            batch.assign(nBatch, BlockBuffer());
+            for (int i = 0; i < nBatch; ++i)
+            {
+                prepareBlock(batch[i], windows[((first + i) * stride + sampleOffset) % nWindows]);
+                if (!readBlock(poDataset, batch[i]))
+                {
+                    pool.waitForDone();
+                    discardProbe();
+                    return 0.0;
+                }
+                pool.start(new BlockProcessor(batch[i], stages, *backend, &isConverting));
+                pixels += qint64(batch[i].window.width) * batch[i].window.height;
+            }
+            pool.waitForDone();
+
+            for (BlockBuffer& buffer : batch)
+            {
+                if (!sink.write(buffer))
+                {
+                    discardProbe();
+                    return 0.0;
+                }
+            }
+        }
+
+        // Closing flushes the last encoded blocks, which belong in the timing
+        GDALClose(poProbe);
+        qint64 elapsed = std::max<qint64>(1, probeTimer.nsecsElapsed());
+        VSIUnlink(probePath.toStdString().c_str());
+        return static_cast<double>(pixels) * 1e9 / elapsed;
+    }
+
+    static int progressCallback(double dfComplete, const char* pszMessage, void* pProgressArg)
+    {
+        Worker* worker = static_cast<Worker*>(pProgressArg);
+        if (worker->isConverting.load())
+        {
+            emit worker->progressUpdated(static_cast<float>(dfComplete));
+            return TRUE; // Continue processing
+        }
+        else
+        {
+            return FALSE; // Cancel processing
+        }
+    }
+
+    QString inputFile;
+    QString outputFile;
+    QString inputDriverName;
+    QString outputDriverName;
+    QMap<QString, QString> gdalOptions;
+    std::atomic<bool> isConverting;
+    std::atomic<qint64> cancelRequestedAt{0}; // steady clock ticks
+    ProcessingMode processingMode;
+    int numCores;
+    ConversionSettings settings;
+    const ComputeBackend* backend = nullptr;
+    std::vector<int> sourceBands;
+    std::vector<std::unique_ptr<BlockStage>> stages;
+    std::unique_ptr<MappedInput> mappedInput;
+    std::unique_ptr<WindowManifest> manifest;
+    bool manifestReuse = false;
+    QThreadPool* sharedPool = nullptr;
+    std::shared_ptr<WindowQuota> windowQuota;
+#ifdef HAVE_IO_URING
+    std::unique_ptr<UringTileReader> tileReader;
+#endif
+};
+
+// A raster driver as offered in the driver lists and file dialogs
+struct DriverEntry
+{
+    QString shortName;
+    QString longName;
+    QString extensions; // space separated, first one is the default
+    bool canCreate = false;
+    bool canCreateCopy = false;
+
+    bool writable() const { return canCreate || canCreateCopy; }
+
+    bool operator==(const DriverEntry& other) const
+    {
+        return shortName == other.shortName && longName == other.longName && extensions == other.extensions &&
+               canCreate == other.canCreate && canCreateCopy == other.canCreateCopy;
+    }
+};
+
+// One entry of a driver's GDAL_DMD_CREATIONOPTIONLIST
+struct CreationOption
+{
+    QString name;
+    QString type;
+    QString defaultValue;
+    QString description;
+    QString minValue;
+    QString maxValue;
+    QStringList values; // enumerated choices, empty for free text
+};
+
+static std::vector<CreationOption> parseCreationOptions(const char* optionList)
+{
+    std::vector<CreationOption> options;
+    CPLXMLNode* psNode = optionList ? CPLParseXMLString(optionList) : nullptr;
+    if (!psNode)
+        return options;
+
+    for (CPLXMLNode* psChild = psNode->psChild; psChild; psChild = psChild->psNext)
+    {
+        const char* optionName = CPLGetXMLValue(psChild, "name", nullptr);
+        if (!EQUAL(psChild->pszValue, "Option") || !optionName)
+            continue;
+
+        CreationOption option;
+        option.name = optionName;
+        option.type = QString(CPLGetXMLValue(psChild, "type", "string")).toLower();
+        option.defaultValue = CPLGetXMLValue(psChild, "default", "");
+        option.description = CPLGetXMLValue(psChild, "description", "");
+        option.minValue = CPLGetXMLValue(psChild, "min", "");
+        option.maxValue = CPLGetXMLValue(psChild, "max", "");
+        for (CPLXMLNode* psValueNode = psChild->psChild; psValueNode; psValueNode = psValueNode->psNext)
+        {
+            if (EQUAL(psValueNode->pszValue, "Value"))
+                option.values.append(CPLGetXMLValue(psValueNode, nullptr, ""));
+        }
+        options.push_back(option);
+    }
+    CPLDestroyXMLNode(psNode);
+    return options;
+}
 
+// Raster driver list, cached in QSettings because walking every driver's
+// metadata after GDALAllRegister() takes seconds with full plugin sets.
+// The cache is keyed by the GDAL version and the modification times of
+// the GDAL_DRIVER_PATH directories, so upgrades invalidate it up front;
+// plugins added to the default directory are caught by the background
+// rescan that always follows registration
+class DriverCatalogue
+{
 public:
-    enum ProcessingMode { CPU, GPU };
-    Q_ENUM(ProcessingMode)
+    static QString fingerprint()
+    {
+        QStringList parts(QString(GDALVersionInfo("VERSION_NUM")));
+        const char* driverPath = CPLGetConfigOption("GDAL_DRIVER_PATH", nullptr);
+        if (driverPath)
+        {
+            for (const QString& dir : QString(driverPath).split(QDir::listSeparator(), Qt::SkipEmptyParts))
+                parts << dir + "@" + QString::number(QFileInfo(dir).lastModified().toMSecsSinceEpoch());
+        }
+        return parts.join('|');
+    }
 
-    Worker(QString inputPath, QString outputPath, QString inputDriverName, QString outputDriverName, QMap<QString, QString> options, ProcessingMode mode, int numCores)
-        : inputFile(std::move(inputPath)), outputFile(std::move(outputPath)),
-          inputDriverName(std::move(inputDriverName)), outputDriverName(std::move(outputDriverName)),
-          gdalOptions(std::move(options)), isConverting(true), processingMode(mode), numCores(numCores) {}
+    static bool loadCached(std::vector<DriverEntry>& entries)
+    {
+        QSettings cache;
+        cache.beginGroup("DriverCatalogue");
+        if (cache.value("fingerprint").toString() != fingerprint())
+            return false;
+
+        entries.clear();
+        for (const QString& line : cache.value("drivers").toStringList())
+        {
+            QStringList fields = line.split('\t');
+            if (fields.size() != 4)
+                return false;
+
+            DriverEntry entry;
+            entry.shortName = fields[0];
+            entry.longName = fields[1];
+            entry.extensions = fields[2];
+            entry.canCreate = fields[3].contains('C');
+            entry.canCreateCopy = fields[3].contains('c');
+            entries.push_back(entry);
+        }
+        return !entries.empty();
+    }
+
+    static void save(const std::vector<DriverEntry>& entries)
+    {
+        QStringList lines;
+        for (const DriverEntry& entry : entries)
+        {
+            QString flags = QString(entry.canCreate ? "C" : "") + (entry.canCreateCopy ? "c" : "");
+            lines << QStringList{entry.shortName, entry.longName, entry.extensions, flags}.join('\t');
+        }
+
+        QSettings cache;
+        cache.beginGroup("DriverCatalogue");
+        cache.setValue("fingerprint", fingerprint());
+        cache.setValue("drivers", lines);
+    }
+
+    // Single pass over the registered drivers; GDAL must be registered
+    static std::vector<DriverEntry> scan()
+    {
+        std::vector<DriverEntry> entries;
+        GDALDriverManager* manager = GetGDALDriverManager();
+        for (int i = 0; i < manager->GetDriverCount(); ++i)
+        {
+            GDALDriver* driver = manager->GetDriver(i);
+            if (!driver || driver->GetMetadataItem(GDAL_DCAP_RASTER) == nullptr)
+                continue;
+
+            DriverEntry entry;
+            entry.shortName = driver->GetDescription();
+            entry.longName = driver->GetMetadataItem(GDAL_DMD_LONGNAME);
+            const char* extensions = driver->GetMetadataItem(GDAL_DMD_EXTENSIONS);
+            if (!extensions)
+                extensions = driver->GetMetadataItem(GDAL_DMD_EXTENSION);
+            entry.extensions = QString(extensions).simplified();
+            entry.canCreate = driver->GetMetadataItem(GDAL_DCAP_CREATE) != nullptr;
+            entry.canCreateCopy = driver->GetMetadataItem(GDAL_DCAP_CREATECOPY) != nullptr;
+            entries.push_back(entry);
+        }
+        return entries;
+    }
+};
+
+// Registers GDAL's drivers off the GUI thread and reports it straight
+// away, then rescans the catalogue and saves it when it differs from the
+// cached one, which the fingerprint alone cannot always tell (e.g. plugins
+// in the default plugin directory)
+class DriverLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DriverLoader(std::vector<DriverEntry> cached) : drivers(std::move(cached)) {}
 
-    ~Worker() override = default;
+    // The cached list until scanned() has been emitted, then the scanned one
+    std::vector<DriverEntry> drivers;
 
 public slots:
     void process()
     {
-        emit logMessage("Starting GDAL conversion...");
-
-        // Open the input file
-        GDALDataset* poDataset = static_cast<GDALDataset*>(GDALOpenEx(
-            inputFile.toStdString().c_str(), GDAL_OF_READONLY, nullptr, nullptr, nullptr));
+        static std::once_flag gdalInitFlag;
+        std::call_once(gdalInitFlag, []() {
+            GDALAllRegister();
+        });
+        emit registered();
 
-        if (!poDataset)
+        std::vector<DriverEntry> entries = DriverCatalogue::scan();
+        bool changed = entries != drivers;
+        if (changed)
         {
-            QString errorMsg = "Failed to open input file: " + inputFile + "\nGDAL Error: " + QString(CPLGetLastErrorMsg());
-            emit finished(false, errorMsg);
-            return;
+            drivers = std::move(entries);
+            DriverCatalogue::save(drivers);
         }
+        emit scanned(changed);
+    }
 
-        emit logMessage("Input file opened successfully.");
+signals:
+    // GDAL can be used from here on
+    void registered();
+    void scanned(bool changed);
+};
 
-        // Get the output driver
-        GDALDriver* poOutDriver = GetGDALDriverManager()->GetDriverByName(outputDriverName.toStdString().c_str());
-        if (!poOutDriver)
+// Headless service mode. GDAL stays registered and one thread pool stays
+// warm across jobs, which are submitted over a local socket (a Unix domain
+// socket on Unix). Requests and events are JSON objects, one per line:
+//
+//   {"op":"convert","input":"in.tif","output":"out.tif","outputDriver":"GTiff",
+//    "options":{"COMPRESS":"ZSTD"},"threads":4,"memoryMB":512,
+//    "priority":"interactive","weight":2,"settings":{"blockSize":512,"gdalProfile":"nfs"}}
+//   {"op":"cancel","job":7}
+//   {"op":"status"}
+//
+// A convert request is answered with {"event":"queued","job":N}; the same
+// connection then receives "started", "progress", "log" and "finished"
+// events for the job, plus "quota" events when its share of the pool
+// changes. The "started" event records the job's GDAL profile and the
+// options applied for it as "gdalProfile" and "gdalConfig". The
+// "finished" event of a cancelled job carries "cancelLatencyMs", the time
+// from the request until the job stopped.
+//
+// Queued jobs start by priority, then submission order, while their memory
+// fits the budget. Running jobs share the pool through window quotas:
+// priorities are served strictly in order ("interactive", "normal",
+// "bulk"), and jobs of one priority split what is left in proportion to
+// their weight, each capped at its thread count. A job left with no quota
+// pauses after its current batch, so previews preempt archive work within
+// one window's processing time
+class ConversionDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Priority { Bulk, Normal, Interactive };
+
+    ConversionDaemon(int coreBudget, qint64 memoryBudgetMB)
+        : coreBudget(std::max(1, coreBudget)), memoryBudgetMB(std::max<qint64>(1, memoryBudgetMB))
+    {
+        // Block processing of every job shares these threads
+        pool.setMaxThreadCount(this->coreBudget);
+        pool.setExpiryTimeout(-1);
+
+        connect(&server, &QLocalServer::newConnection, this, &ConversionDaemon::acceptConnections);
+    }
+
+    bool listen(const QString& path, QString& error)
+    {
+        QLocalServer::removeServer(path); // a stale socket from an earlier run
+        server.setSocketOptions(QLocalServer::UserAccessOption);
+        if (!server.listen(path))
         {
-            QString errorMsg = "Output driver not available: " + outputDriverName;
-            GDALClose(poDataset);
-            emit finished(false, errorMsg);
-            return;
+            error = server.errorString();
+            return false;
         }
+        return true;
+    }
 
-        emit logMessage("Output driver found: " + outputDriverName);
+    // Pool threads shared by all jobs (--cores)
+    int cores() const { return coreBudget; }
 
-        // Set creation options for the output file
-        char** papszOptions = nullptr;
-        for (auto it = gdalOptions.begin(); it != gdalOptions.end(); ++it)
+    static bool isWritableDriver(const QString& name)
+    {
+        GDALDriver* driver = GetGDALDriverManager()->GetDriverByName(name.toStdString().c_str());
+        return driver && driver->GetMetadataItem(GDAL_DCAP_RASTER) &&
+               (driver->GetMetadataItem(GDAL_DCAP_CREATE) || driver->GetMetadataItem(GDAL_DCAP_CREATECOPY));
+    }
+
+    // Queues a job on behalf of the process itself; jobFinished() reports it
+    int submitJob(const QString& input, const QString& output, const QString& outputDriver, const ConversionSettings& settings, int threads)
+    {
+        auto job = std::make_unique<Job>();
+        job->input = input;
+        job->output = output;
+        job->outputDriver = outputDriver;
+        job->settings = settings;
+        job->threads = std::clamp(threads, 1, coreBudget);
+        job->memoryMB = std::min(estimateMemoryMB(job->threads, settings.blockSize), memoryBudgetMB);
+        return enqueue(std::move(job));
+    }
+
+signals:
+    void jobFinished(int id, bool success, const QString& message);
+
+private slots:
+    void acceptConnections()
+    {
+        while (QLocalSocket* socket = server.nextPendingConnection())
         {
-            papszOptions = CSLSetNameValue(papszOptions, it.key().toStdString().c_str(), it.value().toStdString().c_str());
-            emit logMessage(QString("Setting GDAL option: %1 = %2").arg(it.key(), it.value()));
+            connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readRequests(socket); });
+            connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
         }
+    }
 
-        // Check if driver supports Create method
-        bool bCreateSupported = poOutDriver->GetMetadataItem(GDAL_DCAP_CREATE) != nullptr;
-
-        if (processingMode == CPU)
+private:
+    struct Job
+    {
+        int id = 0;
+        QPointer<QLocalSocket> client; // events are dropped once it disconnects
+        QString input;
+        QString output;
+        QString inputDriver;
+        QString outputDriver;
+        QMap<QString, QString> options;
+        Worker::ProcessingMode mode = Worker::SIMD;
+        int threads = 1; // most windows in flight at once
+        qint64 memoryMB = 0;
+        int priority = Normal;
+        double weight = 1.0;
+        ConversionSettings settings;
+
+        Worker* worker = nullptr; // set while running
+        std::shared_ptr<WindowQuota> quota;
+        int windows = 0; // current quota
+        int lastPercent = -1;
+        std::shared_ptr<std::atomic<qint64>> cancelLatencyMs = std::make_shared<std::atomic<qint64>>(-1); // set when a cancelled worker stops
+    };
+
+    void readRequests(QLocalSocket* socket)
+    {
+        while (socket->canReadLine())
         {
-            emit logMessage("Processing mode: CPU");
+            QByteArray line = socket->readLine().trimmed();
+            if (line.isEmpty())
+                continue;
 
-            if (bCreateSupported)
+            QJsonParseError parseError;
+            QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+            if (!document.isObject())
             {
-                // Proceed with Create method
-                if (!processWithCreateMethod(poDataset, poOutDriver, papszOptions))
-                {
-                    GDALClose(poDataset);
-                    CSLDestroy(papszOptions);
-                    return;
-                }
-            }
-            else if (poOutDriver->GetMetadataItem(GDAL_DCAP_CREATECOPY) != nullptr)
-            {
-                // Use CreateCopy method
-                if (!processWithCreateCopyMethod(poDataset, poOutDriver, papszOptions))
-                {
-                    GDALClose(poDataset);
-                    CSLDestroy(papszOptions);
-                    return;
-                }
-            }
-            else
-            {
-                QString errorMsg = "Output driver does not support Create or CreateCopy methods.";
-                GDALClose(poDataset);
-                CSLDestroy(papszOptions);
-                emit finished(false, errorMsg);
-                return;
+                sendError(socket, "Malformed request: " + parseError.errorString());
+                continue;
             }
+            handleRequest(socket, document.object());
+        }
+    }
 
-            GDALClose(poDataset);
-            CSLDestroy(papszOptions);
+    void handleRequest(QLocalSocket* socket, const QJsonObject& request)
+    {
+        QString op = request.value("op").toString();
+        if (op == "convert")
+            submit(socket, request);
+        else if (op == "cancel")
+            cancel(socket, request.value("job").toInt());
+        else if (op == "status")
+            sendStatus(socket);
+        else
+            sendError(socket, "Unknown op: " + op);
+    }
 
-            emit logMessage("Conversion process completed successfully.");
-            emit finished(true, "Conversion completed successfully: " + outputFile);
-        }
-        else if (processingMode == GPU)
+    void submit(QLocalSocket* socket, const QJsonObject& request)
+    {
+        auto job = std::make_unique<Job>();
+        job->client = socket;
+        job->input = request.value("input").toString();
+        job->output = request.value("output").toString();
+        job->inputDriver = request.value("inputDriver").toString();
+        job->outputDriver = request.value("outputDriver").toString("GTiff");
+        job->mode = request.value("mode").toString("simd") == "cpu" ? Worker::CPU : Worker::SIMD;
+        job->priority = QStringList{"bulk", "normal", "interactive"}.indexOf(request.value("priority").toString("normal").toLower());
+        job->weight = request.value("weight").toDouble(1.0);
+
+        QString error;
+        if (job->input.isEmpty() || job->output.isEmpty())
+            error = "Both input and output are required.";
+        else if (job->priority < 0)
+            error = "priority must be one of: bulk, normal, interactive";
+        else if (!(job->weight > 0.0))
+            error = "weight must be positive.";
+        else if (!isWritableDriver(job->outputDriver))
+            error = "Output driver cannot write: " + job->outputDriver;
+        else
+            settingsFromJson(request.value("settings").toObject(), job->settings, error);
+        if (!error.isEmpty())
         {
-            emit logMessage("Processing mode: GPU");
+            sendError(socket, error);
+            return;
+        }
 
-            // Placeholder for GPU processing code
-            GDALClose(poDataset);
-            CSLDestroy(papszOptions);
+        QJsonObject options = request.value("options").toObject();
+        for (auto it = options.begin(); it != options.end(); ++it)
+            job->options.insert(it.key(), it.value().toVariant().toString());
+
+        // A job larger than the whole budget still runs, on its own
+        job->threads = std::clamp(request.value("threads").toInt(coreBudget), 1, coreBudget);
+        qint64 memoryMB = request.contains("memoryMB") ? static_cast<qint64>(request.value("memoryMB").toDouble())
+                                                       : estimateMemoryMB(job->threads, job->settings.blockSize);
+        job->memoryMB = std::clamp<qint64>(memoryMB, 1, memoryBudgetMB);
+
+        enqueue(std::move(job));
+    }
+
+    int enqueue(std::unique_ptr<Job> job)
+    {
+        int id = nextJobId++;
+        job->id = id;
+        send(job->client, QJsonObject{{"event", "queued"}, {"job", id}});
+
+        // Behind every queued job of the same or a higher priority
+        auto position = std::find_if(queue.begin(), queue.end(), [&](int other) { return jobs[other]->priority < job->priority; });
+        queue.insert(position, id);
+        jobs[id] = std::move(job);
+        schedule();
+        return id;
+    }
 
-            emit logMessage("GPU processing is not yet implemented.");
-            emit finished(false, "GPU processing is not yet implemented.");
+    void cancel(QLocalSocket* socket, int id)
+    {
+        auto it = jobs.find(id);
+        if (it == jobs.end())
+        {
+            sendError(socket, QString("No such job: %1").arg(id));
             return;
         }
-        else
+
+        if (it->second->worker)
         {
-            // Unknown processing mode
-            GDALClose(poDataset);
-            CSLDestroy(papszOptions);
-            emit finished(false, "Unknown processing mode selected.");
+            it->second->worker->requestInterruption();
             return;
         }
+
+        // Still queued: it never started, so it finishes here, and the
+        // jobs behind it may now fit
+        queue.erase(std::find(queue.begin(), queue.end(), id));
+        finishJob(id, false, "Cancelled before starting.");
+        schedule();
     }
 
-    void requestInterruption()
+    void sendStatus(QLocalSocket* socket)
     {
-        isConverting.store(false, std::memory_order_relaxed);
+        QJsonArray running;
+        int coresInUse = 0;
+        for (const auto& [id, job] : jobs)
+        {
+            if (job->worker)
+            {
+                running.append(QJsonObject{{"job", id}, {"priority", job->priority}, {"windows", job->windows}});
+                coresInUse += job->windows;
+            }
+        }
+        send(socket, QJsonObject{{"event", "status"},
+                                 {"running", running},
+                                 {"queued", static_cast<int>(queue.size())},
+                                 {"coresInUse", coresInUse},
+                                 {"coreBudget", coreBudget},
+                                 {"memoryInUseMB", memoryInUseMB},
+                                 {"memoryBudgetMB", memoryBudgetMB}});
     }
 
-signals:
-    void progressUpdated(float progress);
-    void finished(bool success, const QString &message);
-    void logMessage(const QString &message);
-
-private:
-    bool processWithCreateMethod(GDALDataset* poDataset, GDALDriver* poOutDriver, char** papszOptions)
+    // Starts queued jobs while their memory fits and they would get a
+    // share of the pool, either from idle cores or by preempting a lower
+    // priority, then redistributes the pool
+    void schedule()
     {
-        emit logMessage("Using Create method.");
-
-        // Get input dataset dimensions and properties
-        int nBands = poDataset->GetRasterCount();
-        if (nBands == 0)
+        while (!queue.empty())
         {
-            QString errorMsg = "Input dataset has no raster bands.";
-            emit finished(false, errorMsg);
-            return false;
-        }
+            Job& job = *jobs[queue.front()];
+            int wanted = 0;
+            int lowestPriority = Interactive + 1;
+            for (const auto& [id, other] : jobs)
+            {
+                if (other->worker)
+                {
+                    wanted += other->threads;
+                    lowestPriority = std::min(lowestPriority, other->priority);
+                }
+            }
 
-        int nXSize = poDataset->GetRasterXSize();
-        int nYSize = poDataset->GetRasterYSize();
-        GDALDataType eType = poDataset->GetRasterBand(1)->GetRasterDataType();
+            bool idle = wanted == 0;
+            bool getsCores = wanted < coreBudget || job.priority > lowestPriority;
+            if (!idle && (!getsCores || memoryInUseMB + job.memoryMB > memoryBudgetMB))
+                break;
 
-        // Create output dataset
-        GDALDataset* poOutDataset = poOutDriver->Create(
-            outputFile.toStdString().c_str(),
-            nXSize,
-            nYSize,
-            nBands,
-            eType,
-            papszOptions);
+            queue.pop_front();
+            start(job);
+        }
+        rebalance();
+    }
 
-        if (!poOutDataset)
+    // Weighted fair share of the pool's threads, one priority at a time.
+    // Shares are rounded down and capped at each job's thread count; the
+    // remainder goes round the jobs in submission order
+    void rebalance()
+    {
+        std::vector<Job*> running;
+        for (const auto& [id, job] : jobs)
         {
-            QString errorMsg = "Failed to create output dataset: " + outputFile + "\nGDAL Error: " + QString(CPLGetLastErrorMsg());
-            emit finished(false, errorMsg);
-            return false;
+            if (job->worker)
+                running.push_back(job.get());
         }
+        std::stable_sort(running.begin(), running.end(), [](const Job* a, const Job* b) { return a->priority > b->priority; });
 
-        // Copy projection and geotransform
-        const char* projection = poDataset->GetProjectionRef();
-        if (projection)
+        std::map<Job*, int> share;
+        int free = coreBudget;
+        for (size_t begin = 0; begin < running.size();)
         {
-            poOutDataset->SetProjection(projection);
+            size_t end = begin;
+            while (end < running.size() && running[end]->priority == running[begin]->priority)
+                ++end;
+
+            std::vector<Job*> open(running.begin() + begin, running.begin() + end);
+            while (free > 0 && !open.empty())
+            {
+                double totalWeight = 0.0;
+                for (Job* job : open)
+                    totalWeight += job->weight;
+
+                int handed = 0;
+                for (Job* job : open)
+                {
+                    int portion = static_cast<int>(free * job->weight / totalWeight);
+                    portion = std::min(portion, job->threads - share[job]);
+                    share[job] += portion;
+                    handed += portion;
+                }
+                for (size_t i = 0; handed == 0 && i < open.size() && i < static_cast<size_t>(free); ++i)
+                {
+                    ++share[open[i]];
+                    ++handed;
+                }
+
+                free -= handed;
+                std::erase_if(open, [&](Job* job) { return share[job] >= job->threads; });
+            }
+            begin = end;
         }
 
-        double geotransform[6];
-        if (poDataset->GetGeoTransform(geotransform) == CE_None)
+        for (Job* job : running)
         {
-            poOutDataset->SetGeoTransform(geotransform);
+            if (share[job] != job->windows)
+            {
+                job->windows = share[job];
+                job->quota->set(job->windows);
+                send(job->client, QJsonObject{{"event", "quota"}, {"job", job->id}, {"windows", job->windows}});
+            }
         }
+    }
 
-        // Processing and writing data
-        if (!processData(poDataset, poOutDataset))
+    // The job starts paused; rebalance() hands it its quota
+    void start(Job& job)
+    {
+        memoryInUseMB += job.memoryMB;
+
+        int id = job.id;
+        job.quota = std::make_shared<WindowQuota>(0);
+        job.worker = new Worker(job.input, job.output, job.inputDriver, job.outputDriver, job.options, job.mode, job.threads, job.settings);
+        job.worker->setThreadPool(&pool, job.quota);
+        QThread* thread = new QThread();
+        job.worker->moveToThread(thread);
+
+        connect(thread, &QThread::started, job.worker, &Worker::process);
+        connect(job.worker, &Worker::progressUpdated, this, [this, id](float progress) {
+            // Whole percents only; the worker reports every batch
+            Job* job = findJob(id);
+            int percent = static_cast<int>(progress * 100);
+            if (job && percent != job->lastPercent)
+            {
+                job->lastPercent = percent;
+                send(job->client, QJsonObject{{"event", "progress"}, {"job", id}, {"progress", static_cast<double>(progress)}});
+            }
+        });
+        connect(job.worker, &Worker::logMessage, this, [this, id](const QString& message) {
+            if (Job* job = findJob(id))
+                send(job->client, QJsonObject{{"event", "log"}, {"job", id}, {"message", message}});
+        });
+        // Read in the worker's thread as it stops, before the worker is
+        // deleted, so the event reports the worker's own measurement
+        Worker* worker = job.worker;
+        connect(worker, &Worker::finished, worker, [worker, latency = job.cancelLatencyMs]() {
+            latency->store(worker->cancelLatencyMs());
+        }, Qt::DirectConnection);
+        connect(job.worker, &Worker::finished, this, [this, id](bool success, const QString& message) {
+            finishJob(id, success, message);
+            schedule();
+        });
+        connect(job.worker, &Worker::finished, thread, &QThread::quit);
+        // Queued behind finishJob(), which drops the job, so a cancel
+        // never reaches a deleted worker
+        connect(thread, &QThread::finished, this, [worker]() { delete worker; });
+        connect(thread, &QThread::finished, thread, &QThread::deleteLater);
+
+        QJsonObject started{{"event", "started"}, {"job", id}, {"threads", job.threads}, {"memoryMB", job.memoryMB}};
+        if (const GdalProfile* profile = findGdalProfile(job.settings.gdalProfile))
         {
-            GDALClose(poOutDataset);
-            return false;
+            // As the worker applies it, capped at the job's threads
+            QJsonObject config;
+            for (const auto& [key, value] : profile->appliedOptions(job.threads))
+                config.insert(key, value);
+            started.insert("gdalProfile", profile->name);
+            started.insert("gdalConfig", config);
         }
+        send(job.client, started);
+        thread->start();
+    }
 
-        GDALClose(poOutDataset);
-        return true;
+    void finishJob(int id, bool success, const QString& message)
+    {
+        auto it = jobs.find(id);
+        if (it == jobs.end())
+            return;
+
+        Job& job = *it->second;
+        if (job.worker)
+            memoryInUseMB -= job.memoryMB;
+        QJsonObject event{{"event", "finished"}, {"job", id}, {"success", success}, {"message", message}};
+        if (job.cancelLatencyMs->load() >= 0)
+            event.insert("cancelLatencyMs", static_cast<double>(job.cancelLatencyMs->load()));
+        send(job.client, event);
+        jobs.erase(it);
+        emit jobFinished(id, success, message);
     }
 
-    bool processWithCreateCopyMethod(GDALDataset* poDataset, GDALDriver* poOutDriver, char** papszOptions)
+    Job* findJob(int id)
     {
-        emit logMessage("Using CreateCopy method.");
+        auto it = jobs.find(id);
+        return it != jobs.end() ? it->second.get() : nullptr;
+    }
 
-        // Copy the dataset directly
-        GDALDataset* poOutDataset = poOutDriver->CreateCopy(
-            outputFile.toStdString().c_str(),
-            poDataset,
-            FALSE, // Synchronous copy
-            papszOptions,
-            progressCallback,
-            this);
+    // Working set assumed when the client gives none: a batch of windows
+    // with room for four Float64 bands in and out
+    static qint64 estimateMemoryMB(int threads, int blockSize)
+    {
+        qint64 bytes = static_cast<qint64>(threads) * blockSize * blockSize * 4 * sizeof(double) * 2;
+        return std::max<qint64>(64, bytes >> 20);
+    }
 
-        if (!poOutDataset)
+public:
+    // Keys mirror ConversionSettings; enums are given by lower-case name
+    static bool settingsFromJson(const QJsonObject& object, ConversionSettings& settings, QString& error)
+    {
+        auto choice = [&](const QString& key, const QStringList& names, int& out) {
+            out = names.indexOf(object.value(key).toString().toLower());
+            if (out < 0)
+                error = QString("%1 must be one of: %2").arg(key).arg(names.join(", "));
+            return out >= 0;
+        };
+
+        for (auto it = object.begin(); it != object.end() && error.isEmpty(); ++it)
         {
-            QString errorMsg = "Failed to create output dataset using CreateCopy: " + outputFile + "\nGDAL Error: " + QString(CPLGetLastErrorMsg());
-            emit finished(false, errorMsg);
-            return false;
+            const QString& key = it.key();
+            const QJsonValue value = it.value();
+            int index = 0;
+            if (key == "blockSize")
+                settings.blockSize = std::max(16, value.toInt(settings.blockSize));
+            else if (key == "autotune")
+                settings.autotune = value.toBool();
+            else if (key == "prefetchDistance")
+                settings.prefetchDistance = std::max(0, value.toInt());
+            else if (key == "memoryMapInput")
+                settings.memoryMapInput = value.toBool();
+            else if (key == "numaAware")
+                settings.numaAware = value.toBool();
+            else if (key == "gdalProfile")
+            {
+                settings.gdalProfile = value.toString();
+                if (!settings.gdalProfile.isEmpty() && !findGdalProfile(settings.gdalProfile))
+                    error = "Unknown gdalProfile: " + settings.gdalProfile;
+            }
+            else if (key == "useIoUring")
+                settings.useIoUring = value.toBool();
+            else if (key == "targetSrs")
+                settings.targetSrs = value.toString();
+            else if (key == "targetResolution")
+                settings.targetResolution = value.toDouble();
+            else if (key == "resampling" && choice(key, {"nearest", "bilinear", "cubic", "lanczos", "average"}, index))
+                settings.resampling = static_cast<ResamplingMethod>(index);
+            else if (key == "outputScale")
+                settings.outputScale = value.toDouble(1.0);
+            else if (key == "outputWidth")
+                settings.outputWidth = std::max(0, value.toInt());
+            else if (key == "outputHeight")
+                settings.outputHeight = std::max(0, value.toInt());
+            else if (key == "resizeResampling" && choice(key, {"nearest", "bilinear", "cubic", "lanczos", "average"}, index))
+                settings.resizeResampling = static_cast<ResamplingMethod>(index);
+            else if (key == "bandExpression")
+                settings.bandExpression = value.toString();
+            else if (key == "bandSelection")
+                settings.bandSelection = value.toString();
+            else if (key == "subsetMode" && choice(key, {"none", "pixels", "bbox"}, index))
+                settings.subsetMode = static_cast<ConversionSettings::SubsetMode>(index);
+            else if (key == "subset")
+                settings.subset = value.toString();
+            else if (key == "mosaicInputs")
+            {
+                for (const QJsonValue& path : value.toArray())
+                    settings.mosaicInputs << path.toString();
+            }
+            else if (key == "compositeRule" && choice(key, {"first", "last", "min", "max", "mean"}, index))
+                settings.compositeRule = static_cast<CompositeRule>(index);
+            else if (key == "traversal" && choice(key, {"auto", "row-major", "tile-row-major", "morton", "hilbert"}, index))
+                settings.traversal = static_cast<TraversalOrder>(index);
+            else if (key == "tileMode" && choice(key, {"none", "xyz", "tms"}, index))
+                settings.tileMode = static_cast<ConversionSettings::TileMode>(index);
+            else if (key == "tileFormat")
+                settings.tileFormat = value.toString();
+            else if (key == "minZoom")
+                settings.minZoom = value.toInt();
+            else if (key == "maxZoom")
+                settings.maxZoom = value.toInt();
+            else if (key == "splitColumns")
+                settings.splitColumns = std::max(1, value.toInt());
+            else if (key == "splitRows")
+                settings.splitRows = std::max(1, value.toInt());
+            else if (key == "splitChunkSize")
+                settings.splitChunkSize = std::max(0, value.toInt());
+            else if (key == "incremental")
+                settings.incremental = value.toBool();
+            else if (error.isEmpty())
+                error = "Unknown setting: " + key;
         }
+        return error.isEmpty();
+    }
 
-        // Close the output dataset
-        GDALClose(poOutDataset);
-
-        return true;
+private:
+    static void send(QLocalSocket* socket, const QJsonObject& event)
+    {
+        if (socket && socket->state() == QLocalSocket::ConnectedState)
+            socket->write(QJsonDocument(event).toJson(QJsonDocument::Compact) + '\n');
     }
 
-    bool processData(GDALDataset* poDataset, GDALDataset* poOutDataset)
+    static void sendError(QLocalSocket* socket, const QString& message)
     {
-        // Block processing as before
-        int nXSize = poDataset->GetRasterXSize();
-        int nYSize = poDataset->GetRasterYSize();
-        int nBands = poDataset->GetRasterCount();
+        send(socket, QJsonObject{{"event", "error"}, {"message", message}});
+    }
 
-        int blockSizeX = 256;
-        int blockSizeY = 256;
+    QLocalServer server;
+    QThreadPool pool;
+    int coreBudget;
+    qint64 memoryBudgetMB;
+    qint64 memoryInUseMB = 0;
+    int nextJobId = 1;
+    std::map<int, std::unique_ptr<Job>> jobs; // queued and running
+    std::deque<int> queue;                    // waiting, in submission order
+};
 
-        int nXBlocks = (nXSize + blockSizeX - 1) / blockSizeX;
-        int nYBlocks = (nYSize + blockSizeY - 1) / blockSizeY;
+// Watch-folder ingest for the daemon. New rasters landing in the watched
+// directories are converted into the output directory once they have
+// stopped changing for the settle time, so partially written files are
+// not picked up. At most maxJobs conversions are handed to the daemon at
+// a time; the rest wait here in arrival order.
+//
+// Outputs keep the input's name, with its extension folded in when it is
+// not the output's (x.jp2 -> x_jp2.tif), and go to a subfolder per watched
+// directory when there are several. Each job writes a hidden ".partial"
+// file that is renamed into place on success and deleted otherwise, so
+// the output directory only ever holds complete files and an output newer
+// than its input means it was converted; after a restart, failed and
+// missed files are picked up again
+class FolderWatcher : public QObject
+{
+    Q_OBJECT
 
-        int totalBlocks = nXBlocks * nYBlocks;
-        std::atomic<int> blocksCompleted(0);
+public:
+    FolderWatcher(ConversionDaemon& daemon, QString outputDir, QString outputDriver, int maxJobs, int settleMs)
+        : daemon(daemon), outputDir(std::move(outputDir)), outputDriver(std::move(outputDriver)),
+          maxJobs(std::max(1, maxJobs)), settleMs(std::max(0, settleMs))
+    {
+        // The driver was checked with ConversionDaemon::isWritableDriver()
+        GDALDriver* driver = GetGDALDriverManager()->GetDriverByName(this->outputDriver.toStdString().c_str());
+        const char* extension = driver->GetMetadataItem(GDAL_DMD_EXTENSION);
+        outputExtension = extension && *extension ? QString(extension) : QString("tif");
 
-        // Thread pool
-        QThreadPool threadPool;
-        threadPool.setMaxThreadCount(numCores);
+        connect(&watcher, &QFileSystemWatcher::directoryChanged, this, &FolderWatcher::scan);
+        connect(&daemon, &ConversionDaemon::jobFinished, this, &FolderWatcher::jobFinished);
 
-        // Process blocks
-        emit logMessage(QString("Starting block processing using %1 core(s)...").arg(numCores));
+        settleTimer.setInterval(std::clamp(this->settleMs / 4, 100, 1000));
+        connect(&settleTimer, &QTimer::timeout, this, &FolderWatcher::checkSettled);
+    }
 
-        for (int y = 0; y < nYSize && isConverting.load(); y += blockSizeY)
+    // All directories are watched before any is scanned, because the
+    // output layout depends on how many there are
+    bool watch(const QStringList& dirs)
+    {
+        for (const QString& dir : dirs)
         {
-            int nYBlockSize = std::min(blockSizeY, nYSize - y);
-            for (int x = 0; x < nXSize && isConverting.load(); x += blockSizeX)
+            if (!QFileInfo(dir).isDir() || !watcher.addPath(dir))
             {
-                int nXBlockSize = std::min(blockSizeX, nXSize - x);
-
-                // Read data in the main thread
-                std::vector<std::vector<char>> bandData(nBands);
-                std::vector<GDALDataType> bandTypes(nBands);
-
-                for (int bandIndex = 1; bandIndex <= nBands; ++bandIndex)
-                {
-                    GDALRasterBand* poBand = poDataset->GetRasterBand(bandIndex);
-                    int nPixels = nXBlockSize * nYBlockSize;
-                    GDALDataType eType = poBand->GetRasterDataType();
-                    bandTypes[bandIndex - 1] = eType;
-                    int nBytes = GDALGetDataTypeSizeBytes(eType) * nPixels;
+                std::cerr << "Cannot watch " << dir.toStdString() << std::endl;
+                return false;
+            }
+        }
 
-                    bandData[bandIndex - 1].resize(nBytes);
+        // One subfolder per watched directory, named after it
+        if (dirs.size() > 1)
+        {
+            QStringList labels;
+            for (const QString& dir : dirs)
+            {
+                QString label = QFileInfo(dir).fileName();
+                if (label.isEmpty())
+                    label = "root";
+                QString unique = label;
+                for (int n = 2; labels.contains(unique); ++n)
+                    unique = QString("%1_%2").arg(label).arg(n);
+                labels << unique;
+                subfolders.insert(QFileInfo(dir).absoluteFilePath(), unique);
+            }
+        }
 
-                    CPLErr err = poBand->RasterIO(GF_Read, x, y, nXBlockSize, nYBlockSize, bandData[bandIndex - 1].data(), nXBlockSize, nYBlockSize, eType, 0, 0, nullptr);
+        for (const QString& dir : dirs)
+            scan(dir); // files that landed while nothing was watching
+        return true;
+    }
 
-                    if (err != CE_None)
-                    {
-                        QString errorMsg = "Failed to read data from input dataset.\nGDAL Error: " + QString(CPLGetLastErrorMsg());
-                        emit finished(false, errorMsg);
-                        return false;
-                    }
-                }
+private slots:
+    // Directory events only say something changed; files still being
+    // written are tracked until their size and time stop moving
+    void scan(const QString& dir)
+    {
+        for (const QFileInfo& info : QDir(dir).entryInfoList(QDir::Files | QDir::NoDotAndDotDot))
+        {
+            QString path = info.absoluteFilePath();
+            if (isTemporary(info) || pending.contains(path) || isHandled(info))
+                continue;
+
+            PendingFile file;
+            file.size = info.size();
+            file.modified = info.lastModified();
+            file.stable.start();
+            pending.insert(path, file);
+        }
 
-                // Process data in worker threads
-                class BlockProcessor : public QRunnable
-                {
-                public:
-                    BlockProcessor(std::vector<std::vector<char>>& bandData, int nXBlockSize, int nYBlockSize, int nBands, std::atomic<bool>* isConverting)
-                        : bandData(bandData), nXBlockSize(nXBlockSize), nYBlockSize(nYBlockSize), nBands(nBands), isConverting(isConverting)
-                    {
-                        setAutoDelete(true);
-                    }
+        if (!pending.isEmpty() && !settleTimer.isActive())
+            settleTimer.start();
+    }
 
-                    void run() override
-                    {
-                        if (!isConverting->load())
-                            return;
+    void checkSettled()
+    {
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            QFileInfo info(it.key());
+            if (!info.exists())
+            {
+                it = pending.erase(it);
+                continue;
+            }
 
-                        // Placeholder for data processing
-                        // Add custom processing logic here if needed
-                    }
+            PendingFile& file = it.value();
+            if (info.size() != file.size || info.lastModified() != file.modified)
+            {
+                file.size = info.size();
+                file.modified = info.lastModified();
+                file.stable.restart();
+            }
+            else if (file.stable.elapsed() >= settleMs)
+            {
+                // Settled; anything GDAL cannot read as a raster is ignored
+                if (GDALIdentifyDriverEx(it.key().toStdString().c_str(), GDAL_OF_RASTER, nullptr, nullptr))
+                    queued.push_back(it.key());
+                seen.insert(it.key(), file.modified);
+                it = pending.erase(it);
+                continue;
+            }
+            ++it;
+        }
 
-                private:
-                    std::vector<std::vector<char>>& bandData;
-                    int nXBlockSize;
-                    int nYBlockSize;
-                    int nBands;
-                    std::atomic<bool>* isConverting;
-                };
+        if (pending.isEmpty())
+            settleTimer.stop();
+        dispatch();
+    }
 
-                // Create and start the task
-                BlockProcessor* task = new BlockProcessor(bandData, nXBlockSize, nYBlockSize, nBands, &isConverting);
-                threadPool.start(task);
+    void jobFinished(int id, bool success, const QString& message)
+    {
+        if (!inFlight.contains(id))
+            return;
 
-                if (!isConverting.load())
-                {
-                    // Conversion was cancelled
-                    threadPool.waitForDone();
-                    emit finished(false, "Conversion cancelled by user.");
-                    return false;
-                }
+        InFlightJob job = inFlight.take(id);
+        GDALDriver* driver = GetGDALDriverManager()->GetDriverByName(outputDriver.toStdString().c_str());
+        if (success && driver)
+        {
+            // Rename through the driver so sidecar files move along
+            if (QFileInfo::exists(job.output))
+                driver->Delete(job.output.toStdString().c_str());
+            if (driver->Rename(job.output.toStdString().c_str(), job.partial.toStdString().c_str()) != CE_None)
+            {
+                success = false;
+                std::cerr << "Failed to move " << job.partial.toStdString() << " into place: " << CPLGetLastErrorMsg() << std::endl;
+            }
+        }
+        if (!success && driver && QFileInfo::exists(job.partial))
+            driver->Delete(job.partial.toStdString().c_str());
+
+        if (success)
+            std::cerr << "Converted " << job.input.toStdString() << " -> " << job.output.toStdString() << std::endl;
+        else
+            std::cerr << "Failed to convert " << job.input.toStdString() << ": " << message.toStdString() << std::endl;
+        dispatch();
+    }
 
-                // Wait for the task to complete
-                threadPool.waitForDone();
+private:
+    struct PendingFile
+    {
+        qint64 size = 0;
+        QDateTime modified;
+        QElapsedTimer stable;
+    };
 
-                // Write data back to the output dataset in the main thread
-                for (int bandIndex = 1; bandIndex <= nBands; ++bandIndex)
-                {
-                    GDALRasterBand* poOutBand = poOutDataset->GetRasterBand(bandIndex);
-                    GDALDataType eType = bandTypes[bandIndex - 1];
+    struct InFlightJob
+    {
+        QString input;
+        QString output;
+        QString partial; // written by the job, renamed to output on success
+    };
 
-                    CPLErr err = poOutBand->RasterIO(GF_Write, x, y, nXBlockSize, nYBlockSize, bandData[bandIndex - 1].data(), nXBlockSize, nYBlockSize, eType, 0, 0, nullptr);
+    // Inputs whose output another job is still writing wait in the queue
+    void dispatch()
+    {
+        for (auto it = queued.begin(); it != queued.end() && inFlight.size() < maxJobs;)
+        {
+            QString path = *it;
+            QString output = outputPath(QFileInfo(path));
+            if (isWriting(output))
+            {
+                ++it;
+                continue;
+            }
+            it = queued.erase(it);
 
-                    if (err != CE_None)
-                    {
-                        QString errorMsg = "Failed to write data to output dataset.\nGDAL Error: " + QString(CPLGetLastErrorMsg());
-                        emit finished(false, errorMsg);
-                        return false;
-                    }
-                }
+            // The naming rule is injective in practice; a clash (e.g. x.jp2
+            // beside a file named x_jp2.tif) is reported, not overwritten
+            auto owner = owners.constFind(output);
+            if (owner != owners.constEnd() && owner.value() != path)
+            {
+                std::cerr << "Skipping " << path.toStdString() << ": " << output.toStdString() << " belongs to "
+                          << owner.value().toStdString() << std::endl;
+                continue;
+            }
+            owners.insert(output, path);
 
-                // Update progress
-                blocksCompleted.fetch_add(1, std::memory_order_relaxed);
-                float progress = static_cast<float>(blocksCompleted.load()) / totalBlocks;
-                emit progressUpdated(progress);
+            InFlightJob job{path, output, partialPath(output)};
+            GDALDriver* driver = GetGDALDriverManager()->GetDriverByName(outputDriver.toStdString().c_str());
+            if (driver && QFileInfo::exists(job.partial))
+                driver->Delete(job.partial.toStdString().c_str()); // left by a crash
+            if (!QDir().mkpath(QFileInfo(output).absolutePath()))
+            {
+                std::cerr << "Cannot create " << QFileInfo(output).absolutePath().toStdString() << std::endl;
+                continue;
             }
+
+            // An even share of the daemon's cores, so --cores holds
+            ConversionSettings settings;
+            int threads = std::max(1, daemon.cores() / maxJobs);
+            int id = daemon.submitJob(path, job.partial, outputDriver, settings, threads);
+            inFlight.insert(id, job);
         }
+    }
 
-        if (!isConverting.load())
+    bool isWriting(const QString& output) const
+    {
+        for (auto it = inFlight.begin(); it != inFlight.end(); ++it)
         {
-            // Conversion was cancelled
-            emit finished(false, "Conversion cancelled by user.");
-            return false;
+            if (it.value().output == output)
+                return true;
         }
+        return false;
+    }
 
-        // Final progress update
-        emit progressUpdated(1.0f);
+    QString outputPath(const QFileInfo& input) const
+    {
+        QString name = input.completeBaseName();
+        if (!input.suffix().isEmpty() && input.suffix().compare(outputExtension, Qt::CaseInsensitive) != 0)
+            name += "_" + input.suffix();
+        QDir dir(outputDir);
+        QString subfolder = subfolders.value(input.absolutePath());
+        return dir.filePath(subfolder.isEmpty() ? name + "." + outputExtension : subfolder + "/" + name + "." + outputExtension);
+    }
 
-        return true;
+    // Hidden, so isTemporary() skips it should the output folder be watched too
+    QString partialPath(const QString& output) const
+    {
+        QFileInfo info(output);
+        return info.dir().filePath("." + info.completeBaseName() + ".partial." + outputExtension);
     }
 
-    static int progressCallback(double dfComplete, const char* pszMessage, void* pProgressArg)
+    // Dot files and the usual partial-download names are never inputs
+    static bool isTemporary(const QFileInfo& info)
     {
-        Worker* worker = static_cast<Worker*>(pProgressArg);
-        if (worker->isConverting.load())
-        {
-            emit worker->progressUpdated(static_cast<float>(dfComplete));
-            return TRUE; // Continue processing
-        }
-        else
-        {
-            return FALSE; // Cancel processing
-        }
+        QString name = info.fileName();
+        return name.startsWith(".") || name.endsWith(".part") || name.endsWith(".tmp") || name.endsWith(".crdownload");
     }
 
-    QString inputFile;
-    QString outputFile;
-    QString inputDriverName;
-    QString outputDriverName;
-    QMap<QString, QString> gdalOptions;
-    std::atomic<bool> isConverting;
-    ProcessingMode processingMode;
-    int numCores;
+    bool isHandled(const QFileInfo& info) const
+    {
+        // Settled files are not looked at again until they change
+        auto it = seen.find(info.absoluteFilePath());
+        if (it != seen.end() && it.value() == info.lastModified())
+            return true;
+
+        QFileInfo output(outputPath(info));
+        return output.exists() && output.lastModified() >= info.lastModified();
+    }
+
+    ConversionDaemon& daemon;
+    QString outputDir;
+    QString outputDriver;
+    QString outputExtension;
+    int maxJobs;
+    int settleMs;
+
+    QFileSystemWatcher watcher;
+    QTimer settleTimer;
+    QMap<QString, PendingFile> pending; // waiting to settle
+    std::deque<QString> queued;         // settled, waiting for a job slot
+    QMap<int, InFlightJob> inFlight;    // by daemon job id
+    QMap<QString, QDateTime> seen;      // settled inputs by modification time
+    QMap<QString, QString> subfolders;  // watched directory -> output subfolder
+    QMap<QString, QString> owners;      // output -> the input it was converted from
 };
 
 // Main Window class
@@ -428,8 +6172,20 @@ public:
         QLabel *inputLabel = new QLabel("Input File:");
         inputLineEdit = new QLineEdit();
         QPushButton *browseInputButton = new QPushButton("Browse...");
+        mosaicLabel = new QLabel();
+        QLabel* compositeLabel = new QLabel("Composite:");
+        compositeComboBox = new QComboBox();
+        compositeComboBox->addItem("First", static_cast<int>(CompositeRule::First));
+        compositeComboBox->addItem("Last", static_cast<int>(CompositeRule::Last));
+        compositeComboBox->addItem("Min", static_cast<int>(CompositeRule::Minimum));
+        compositeComboBox->addItem("Max", static_cast<int>(CompositeRule::Maximum));
+        compositeComboBox->addItem("Mean", static_cast<int>(CompositeRule::Mean));
+        compositeComboBox->setToolTip("How overlapping mosaic inputs are combined");
         inputLayout->addWidget(inputLabel);
         inputLayout->addWidget(inputLineEdit);
+        inputLayout->addWidget(mosaicLabel);
+        inputLayout->addWidget(compositeLabel);
+        inputLayout->addWidget(compositeComboBox);
         inputLayout->addWidget(browseInputButton);
         mainLayout->addLayout(inputLayout);
 
@@ -474,11 +6230,11 @@ public:
         // Processing Mode Selection
         QGroupBox* processingModeGroup = new QGroupBox("Processing Mode");
         QHBoxLayout* processingModeLayout = new QHBoxLayout();
-        cpuRadioButton = new QRadioButton("CPU");
-        gpuRadioButton = new QRadioButton("GPU");
+        cpuRadioButton = new QRadioButton("CPU (scalar reference)");
+        simdRadioButton = new QRadioButton(QString("SIMD (%1)").arg(ComputeBackend::simd().name()));
         cpuRadioButton->setChecked(true); // Default to CPU
         processingModeLayout->addWidget(cpuRadioButton);
-        processingModeLayout->addWidget(gpuRadioButton);
+        processingModeLayout->addWidget(simdRadioButton);
         processingModeGroup->setLayout(processingModeLayout);
         mainLayout->addWidget(processingModeGroup);
 
@@ -491,8 +6247,207 @@ public:
         cpuCoresSpinBox->setValue(maxCores); // Default to maximum available cores
         cpuCoresLayout->addWidget(cpuCoresLabel);
         cpuCoresLayout->addWidget(cpuCoresSpinBox);
+
+        // Window size used for block processing
+        QLabel* blockSizeLabel = new QLabel("Block Size:");
+        blockSizeSpinBox = new QSpinBox();
+        blockSizeSpinBox->setRange(64, 4096);
+        blockSizeSpinBox->setSingleStep(64);
+        blockSizeSpinBox->setValue(256);
+        cpuCoresLayout->addWidget(blockSizeLabel);
+        cpuCoresLayout->addWidget(blockSizeSpinBox);
+
+        // Let the engine measure and pick block size and thread count
+        autotuneCheckBox = new QCheckBox("Autotune");
+        autotuneCheckBox->setToolTip("Time short probes to pick block size and thread count; results are cached per format and storage location");
+        cpuCoresLayout->addWidget(autotuneCheckBox);
         mainLayout->addLayout(cpuCoresLayout);
 
+        // Read-ahead distance
+        QHBoxLayout* prefetchLayout = new QHBoxLayout();
+        QLabel* prefetchLabel = new QLabel("Read-ahead (windows):");
+        prefetchSpinBox = new QSpinBox();
+        prefetchSpinBox->setRange(0, 256);
+        prefetchSpinBox->setValue(0);
+        prefetchSpinBox->setSpecialValueText("Off");
+        prefetchSpinBox->setToolTip("Number of windows to hint to GDAL and the OS ahead of reading; helps on network filesystems and spinning disks");
+        prefetchLayout->addWidget(prefetchLabel);
+        prefetchLayout->addWidget(prefetchSpinBox);
+        memoryMapCheckBox = new QCheckBox("Memory-map input");
+        memoryMapCheckBox->setToolTip("Read uncompressed raw/ENVI/GTiff inputs in place instead of copying each window");
+        prefetchLayout->addWidget(memoryMapCheckBox);
+#ifdef __linux__
+        numaCheckBox = new QCheckBox("NUMA-aware");
+        numaCheckBox->setToolTip("On multi-socket hosts, pin processing threads per NUMA node and keep each node's window buffers in its own memory");
+        prefetchLayout->addWidget(numaCheckBox);
+#endif
+        QLabel* gdalProfileLabel = new QLabel("GDAL profile:");
+        gdalProfileComboBox = new QComboBox();
+        gdalProfileComboBox->addItem("Defaults", QString());
+        for (const GdalProfile& profile : gdalProfiles())
+        {
+            gdalProfileComboBox->addItem(profile.name, profile.name);
+            gdalProfileComboBox->setItemData(gdalProfileComboBox->count() - 1, profile.description + "\n" + profile.describe(), Qt::ToolTipRole);
+        }
+        gdalProfileComboBox->setToolTip("GDAL configuration options (cache, swath size, codec threads, I/O caching) applied to the job");
+        prefetchLayout->addWidget(gdalProfileLabel);
+        prefetchLayout->addWidget(gdalProfileComboBox);
+        QLabel* traversalLabel = new QLabel("Traversal:");
+        traversalComboBox = new QComboBox();
+        traversalComboBox->addItem("Auto", static_cast<int>(TraversalOrder::Auto));
+        traversalComboBox->addItem("Row-major", static_cast<int>(TraversalOrder::RowMajor));
+        traversalComboBox->addItem("Tile-row-major", static_cast<int>(TraversalOrder::TileRowMajor));
+        traversalComboBox->addItem("Morton (Z-order)", static_cast<int>(TraversalOrder::Morton));
+        traversalComboBox->addItem("Hilbert", static_cast<int>(TraversalOrder::Hilbert));
+        traversalComboBox->setToolTip("Order windows are processed in; Auto picks the one that re-decodes the fewest input blocks for the GDAL cache size");
+        prefetchLayout->addWidget(traversalLabel);
+        prefetchLayout->addWidget(traversalComboBox);
+        incrementalCheckBox = new QCheckBox("Incremental");
+        incrementalCheckBox->setToolTip("Update an existing output in place, rewriting only windows whose input changed since the last run");
+        prefetchLayout->addWidget(incrementalCheckBox);
+#ifdef HAVE_IO_URING
+        ioUringCheckBox = new QCheckBox("io_uring block reader");
+        ioUringCheckBox->setToolTip("Read uncompressed GTiff tiles/strips with io_uring at high queue depth");
+        prefetchLayout->addWidget(ioUringCheckBox);
+#endif
+        mainLayout->addLayout(prefetchLayout);
+
+        // Reprojection
+        QHBoxLayout* warpLayout = new QHBoxLayout();
+        QLabel* targetSrsLabel = new QLabel("Target CRS:");
+        targetSrsLineEdit = new QLineEdit();
+        targetSrsLineEdit->setPlaceholderText("e.g. EPSG:3857 (empty = keep input CRS)");
+        QLabel* resolutionLabel = new QLabel("Resolution:");
+        resolutionSpinBox = new QDoubleSpinBox();
+        resolutionSpinBox->setRange(0.0, 1e9);
+        resolutionSpinBox->setDecimals(9);
+        resolutionSpinBox->setValue(0.0);
+        resolutionSpinBox->setSpecialValueText("Auto");
+        resolutionSpinBox->setToolTip("Output pixel size in target CRS units");
+        QLabel* resamplingLabel = new QLabel("Resampling:");
+        resamplingComboBox = new QComboBox();
+        resamplingComboBox->addItem("Nearest", static_cast<int>(ResamplingMethod::Nearest));
+        resamplingComboBox->addItem("Bilinear", static_cast<int>(ResamplingMethod::Bilinear));
+        warpLayout->addWidget(targetSrsLabel);
+        warpLayout->addWidget(targetSrsLineEdit);
+        warpLayout->addWidget(resolutionLabel);
+        warpLayout->addWidget(resolutionSpinBox);
+        warpLayout->addWidget(resamplingLabel);
+        warpLayout->addWidget(resamplingComboBox);
+        mainLayout->addLayout(warpLayout);
+
+        // Output size
+        QHBoxLayout* resizeLayout = new QHBoxLayout();
+        QLabel* scaleLabel = new QLabel("Scale (%):");
+        scaleSpinBox = new QDoubleSpinBox();
+        scaleSpinBox->setRange(0.1, 1000.0);
+        scaleSpinBox->setDecimals(1);
+        scaleSpinBox->setValue(100.0);
+        QLabel* outputSizeLabel = new QLabel("or size:");
+        outputWidthSpinBox = new QSpinBox();
+        outputWidthSpinBox->setRange(0, 1000000);
+        outputWidthSpinBox->setSpecialValueText("Auto");
+        outputHeightSpinBox = new QSpinBox();
+        outputHeightSpinBox->setRange(0, 1000000);
+        outputHeightSpinBox->setSpecialValueText("Auto");
+        outputWidthSpinBox->setToolTip("Output width in pixels; overrides the scale");
+        outputHeightSpinBox->setToolTip("Output height in pixels; overrides the scale");
+        QLabel* resizeKernelLabel = new QLabel("Kernel:");
+        resizeKernelComboBox = new QComboBox();
+        resizeKernelComboBox->addItem("Average", static_cast<int>(ResamplingMethod::Average));
+        resizeKernelComboBox->addItem("Nearest", static_cast<int>(ResamplingMethod::Nearest));
+        resizeKernelComboBox->addItem("Bilinear", static_cast<int>(ResamplingMethod::Bilinear));
+        resizeKernelComboBox->addItem("Cubic", static_cast<int>(ResamplingMethod::Cubic));
+        resizeKernelComboBox->addItem("Lanczos", static_cast<int>(ResamplingMethod::Lanczos));
+        resizeLayout->addWidget(scaleLabel);
+        resizeLayout->addWidget(scaleSpinBox);
+        resizeLayout->addWidget(outputSizeLabel);
+        resizeLayout->addWidget(outputWidthSpinBox);
+        resizeLayout->addWidget(new QLabel("x"));
+        resizeLayout->addWidget(outputHeightSpinBox);
+        resizeLayout->addWidget(resizeKernelLabel);
+        resizeLayout->addWidget(resizeKernelComboBox);
+        mainLayout->addLayout(resizeLayout);
+
+        // Band math
+        QHBoxLayout* bandMathLayout = new QHBoxLayout();
+        QLabel* bandMathLabel = new QLabel("Band math:");
+        bandMathLineEdit = new QLineEdit();
+        bandMathLineEdit->setPlaceholderText("e.g. (B4-B3)/(B4+B3); separate output bands with ';'");
+        bandMathLineEdit->setToolTip("Operators + - * / and min(a,b), max(a,b); B1 is the first selected input band. Outputs Float32");
+        QLabel* bandSelectionLabel = new QLabel("Bands:");
+        bandSelectionLineEdit = new QLineEdit();
+        bandSelectionLineEdit->setPlaceholderText("e.g. 4,3,2 (empty = all)");
+        bandSelectionLineEdit->setToolTip("Input bands to read, in output order; ranges like 1-3 are allowed. Band math B1 is the first selected band");
+        bandMathLayout->addWidget(bandSelectionLabel);
+        bandMathLayout->addWidget(bandSelectionLineEdit);
+        bandMathLayout->addWidget(bandMathLabel);
+        bandMathLayout->addWidget(bandMathLineEdit);
+        mainLayout->addLayout(bandMathLayout);
+
+        // Spatial subset
+        QHBoxLayout* subsetLayout = new QHBoxLayout();
+        QLabel* subsetLabel = new QLabel("Subset:");
+        subsetComboBox = new QComboBox();
+        subsetComboBox->addItem("Whole input", static_cast<int>(ConversionSettings::NoSubset));
+        subsetComboBox->addItem("Pixel window", static_cast<int>(ConversionSettings::PixelWindow));
+        subsetComboBox->addItem("Bounding box", static_cast<int>(ConversionSettings::BoundingBox));
+        subsetLineEdit = new QLineEdit();
+        subsetLineEdit->setEnabled(false);
+        subsetLayout->addWidget(subsetLabel);
+        subsetLayout->addWidget(subsetComboBox);
+        subsetLayout->addWidget(subsetLineEdit);
+        mainLayout->addLayout(subsetLayout);
+
+        // Web map tiles
+        QHBoxLayout* tilesLayout = new QHBoxLayout();
+        QLabel* tilesLabel = new QLabel("Web tiles:");
+        tileModeComboBox = new QComboBox();
+        tileModeComboBox->addItem("Off", static_cast<int>(ConversionSettings::NoTiles));
+        tileModeComboBox->addItem("XYZ", static_cast<int>(ConversionSettings::XyzTiles));
+        tileModeComboBox->addItem("TMS", static_cast<int>(ConversionSettings::TmsTiles));
+        tileModeComboBox->setToolTip("Write a z/x/y tile pyramid into the output path (a folder) instead of one file");
+        tileFormatComboBox = new QComboBox();
+        tileFormatComboBox->addItems({"PNG", "WEBP", "JPEG"});
+        QLabel* zoomLabel = new QLabel("Zoom:");
+        minZoomSpinBox = new QSpinBox();
+        minZoomSpinBox->setRange(0, 24);
+        maxZoomSpinBox = new QSpinBox();
+        maxZoomSpinBox->setRange(-1, 24);
+        maxZoomSpinBox->setValue(-1);
+        maxZoomSpinBox->setSpecialValueText("Auto");
+        maxZoomSpinBox->setToolTip("Deepest zoom level; Auto matches the input resolution");
+        tilesLayout->addWidget(tilesLabel);
+        tilesLayout->addWidget(tileModeComboBox);
+        tilesLayout->addWidget(tileFormatComboBox);
+        tilesLayout->addWidget(zoomLabel);
+        tilesLayout->addWidget(minZoomSpinBox);
+        tilesLayout->addWidget(new QLabel("to"));
+        tilesLayout->addWidget(maxZoomSpinBox);
+        mainLayout->addLayout(tilesLayout);
+
+        // Split output
+        QHBoxLayout* splitLayout = new QHBoxLayout();
+        QLabel* splitLabel = new QLabel("Split into:");
+        splitColumnsSpinBox = new QSpinBox();
+        splitColumnsSpinBox->setRange(1, 1000);
+        splitRowsSpinBox = new QSpinBox();
+        splitRowsSpinBox->setRange(1, 1000);
+        QLabel* splitChunkLabel = new QLabel("files, or chunks of");
+        splitChunkSpinBox = new QSpinBox();
+        splitChunkSpinBox->setRange(0, 1000000);
+        splitChunkSpinBox->setSingleStep(1000);
+        splitChunkSpinBox->setSpecialValueText("Off");
+        splitChunkSpinBox->setSuffix(" px");
+        splitChunkSpinBox->setToolTip("Square chunk size in pixels; overrides the file grid. Files are named <name>_<row>_<col>");
+        splitLayout->addWidget(splitLabel);
+        splitLayout->addWidget(splitColumnsSpinBox);
+        splitLayout->addWidget(new QLabel("x"));
+        splitLayout->addWidget(splitRowsSpinBox);
+        splitLayout->addWidget(splitChunkLabel);
+        splitLayout->addWidget(splitChunkSpinBox);
+        mainLayout->addLayout(splitLayout);
+
         // Start and Cancel Buttons
         QHBoxLayout *buttonLayout = new QHBoxLayout();
         startButton = new QPushButton("Start Conversion");
@@ -533,22 +6488,34 @@ public:
         connect(inputLineEdit, &QLineEdit::textChanged,
                 this, [this](const QString &){ updateOutputFileExtension(); });
 
+        // Typing a different input leaves mosaic mode
+        connect(inputLineEdit, &QLineEdit::textChanged, this, [this](const QString& text){
+            if (!mosaicFiles.isEmpty() && text != mosaicFiles.first())
+                mosaicFiles.clear();
+            updateMosaicLabel();
+        });
+        updateMosaicLabel();
+
         connect(useOptionsCheckBox, &QCheckBox::toggled, optionsGroup, &QGroupBox::setEnabled);
 
         // Initialize Timer for ETA calculation
         timer = std::make_unique<QElapsedTimer>();
 
-        // Initialize GDAL and populate driver lists
+        // Populate driver lists and register GDAL in the background
         initializeGDAL();
 
         // Update options when output driver changes
         connect(outputDriverComboBox, &QComboBox::currentTextChanged, this, &MainWindow::updateOptions);
 
-        // Ensure CPU cores selection is only enabled in CPU mode
-        connect(cpuRadioButton, &QRadioButton::toggled, this, [this](bool checked){
-            cpuCoresSpinBox->setEnabled(checked);
+        // The subset text is interpreted according to the chosen mode
+        connect(subsetComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int){
+            updateSubsetField();
+        });
+
+        // Manual block size only applies when autotune is off
+        connect(autotuneCheckBox, &QCheckBox::toggled, this, [this](bool checked){
+            blockSizeSpinBox->setEnabled(!checked);
         });
-        cpuCoresSpinBox->setEnabled(cpuRadioButton->isChecked());
     }
 
     ~MainWindow() override
@@ -563,16 +6530,25 @@ public:
             thread->quit();
             thread->wait();
         }
+        if (driverThread)
+        {
+            driverThread->quit();
+            driverThread->wait();
+            delete driverThread;
+        }
     }
 
 private slots:
     void browseInputFile()
     {
         QString selectedFilter;
-        QString fileName = QFileDialog::getOpenFileName(this, "Select Input File", "", inputFileFilter, &selectedFilter);
-        if (!fileName.isEmpty())
+        // Selecting several files mosaics them
+        QStringList fileNames = QFileDialog::getOpenFileNames(this, "Select Input File(s)", "", inputFileFilter, &selectedFilter);
+        if (!fileNames.isEmpty())
         {
-            inputLineEdit->setText(fileName);
+            mosaicFiles = fileNames.size() > 1 ? fileNames : QStringList();
+            inputLineEdit->setText(fileNames.first());
+            updateMosaicLabel();
         }
     }
 
@@ -612,8 +6588,10 @@ private slots:
 
         if (useOptionsCheckBox->isChecked())
         {
-            // Gather options from the optionsLayout
-            QList<QWidget*> optionWidgets = optionsGroup->findChildren<QWidget*>();
+            // Gather options from the selected driver's panel
+            QList<QWidget*> optionWidgets;
+            if (currentOptionPanel)
+                optionWidgets = currentOptionPanel->findChildren<QWidget*>();
             for (QWidget* widget : optionWidgets)
             {
                 QString key = widget->property("optionKey").toString();
@@ -650,11 +6628,46 @@ private slots:
         }
 
         // Determine processing mode
-        Worker::ProcessingMode mode = cpuRadioButton->isChecked() ? Worker::CPU : Worker::GPU;
+        Worker::ProcessingMode mode = cpuRadioButton->isChecked() ? Worker::CPU : Worker::SIMD;
 
         // Get number of CPU cores to use
         int numCores = cpuCoresSpinBox->value();
 
+        ConversionSettings settings;
+        settings.blockSize = blockSizeSpinBox->value();
+        settings.autotune = autotuneCheckBox->isChecked();
+        settings.prefetchDistance = prefetchSpinBox->value();
+        settings.memoryMapInput = memoryMapCheckBox->isChecked();
+        settings.incremental = incrementalCheckBox->isChecked();
+#ifdef __linux__
+        settings.numaAware = numaCheckBox->isChecked();
+#endif
+        settings.gdalProfile = gdalProfileComboBox->currentData().toString();
+        settings.traversal = static_cast<TraversalOrder>(traversalComboBox->currentData().toInt());
+        settings.targetSrs = targetSrsLineEdit->text().trimmed();
+        settings.targetResolution = resolutionSpinBox->value();
+        settings.resampling = static_cast<ResamplingMethod>(resamplingComboBox->currentData().toInt());
+        settings.outputScale = scaleSpinBox->value() / 100.0;
+        settings.outputWidth = outputWidthSpinBox->value();
+        settings.outputHeight = outputHeightSpinBox->value();
+        settings.resizeResampling = static_cast<ResamplingMethod>(resizeKernelComboBox->currentData().toInt());
+        settings.bandExpression = bandMathLineEdit->text();
+        settings.bandSelection = bandSelectionLineEdit->text();
+        settings.subsetMode = static_cast<ConversionSettings::SubsetMode>(subsetComboBox->currentData().toInt());
+        settings.subset = subsetLineEdit->text();
+        settings.mosaicInputs = mosaicFiles;
+        settings.tileMode = static_cast<ConversionSettings::TileMode>(tileModeComboBox->currentData().toInt());
+        settings.tileFormat = tileFormatComboBox->currentText();
+        settings.minZoom = minZoomSpinBox->value();
+        settings.maxZoom = maxZoomSpinBox->value();
+        settings.splitColumns = splitColumnsSpinBox->value();
+        settings.splitRows = splitRowsSpinBox->value();
+        settings.splitChunkSize = splitChunkSpinBox->value();
+        settings.compositeRule = static_cast<CompositeRule>(compositeComboBox->currentData().toInt());
+#ifdef HAVE_IO_URING
+        settings.useIoUring = ioUringCheckBox->isChecked();
+#endif
+
         // Disable UI elements during conversion
         startButton->setEnabled(false);
         cancelButton->setEnabled(true);
@@ -672,8 +6685,40 @@ private slots:
         optionsGroup->setEnabled(false);
         useOptionsCheckBox->setEnabled(false);
         cpuRadioButton->setEnabled(false);
-        gpuRadioButton->setEnabled(false);
+        simdRadioButton->setEnabled(false);
         cpuCoresSpinBox->setEnabled(false);
+        blockSizeSpinBox->setEnabled(false);
+        autotuneCheckBox->setEnabled(false);
+        prefetchSpinBox->setEnabled(false);
+        memoryMapCheckBox->setEnabled(false);
+        incrementalCheckBox->setEnabled(false);
+#ifdef __linux__
+        numaCheckBox->setEnabled(false);
+#endif
+        gdalProfileComboBox->setEnabled(false);
+        traversalComboBox->setEnabled(false);
+        targetSrsLineEdit->setEnabled(false);
+        resolutionSpinBox->setEnabled(false);
+        resamplingComboBox->setEnabled(false);
+        scaleSpinBox->setEnabled(false);
+        outputWidthSpinBox->setEnabled(false);
+        outputHeightSpinBox->setEnabled(false);
+        resizeKernelComboBox->setEnabled(false);
+        bandMathLineEdit->setEnabled(false);
+        bandSelectionLineEdit->setEnabled(false);
+        subsetComboBox->setEnabled(false);
+        tileModeComboBox->setEnabled(false);
+        tileFormatComboBox->setEnabled(false);
+        minZoomSpinBox->setEnabled(false);
+        maxZoomSpinBox->setEnabled(false);
+        splitColumnsSpinBox->setEnabled(false);
+        splitRowsSpinBox->setEnabled(false);
+        splitChunkSpinBox->setEnabled(false);
+        compositeComboBox->setEnabled(false);
+        subsetLineEdit->setEnabled(false);
+#ifdef HAVE_IO_URING
+        ioUringCheckBox->setEnabled(false);
+#endif
 
         // Reset progress bar and ETA
         progressBar->setValue(0);
@@ -684,7 +6729,7 @@ private slots:
         timer->restart();
 
         // Create and start worker thread
-        worker = new Worker(inputPath, outputPath, inputDriverName, outputDriverName, options, mode, numCores);
+        worker = new Worker(inputPath, outputPath, inputDriverName, outputDriverName, options, mode, numCores, settings);
         thread = new QThread();
 
         worker->moveToThread(thread);
@@ -758,8 +6803,40 @@ private slots:
         optionsGroup->setEnabled(useOptionsCheckBox->isChecked());
         useOptionsCheckBox->setEnabled(true);
         cpuRadioButton->setEnabled(true);
-        gpuRadioButton->setEnabled(true);
-        cpuCoresSpinBox->setEnabled(cpuRadioButton->isChecked());
+        simdRadioButton->setEnabled(true);
+        cpuCoresSpinBox->setEnabled(true);
+        autotuneCheckBox->setEnabled(true);
+        blockSizeSpinBox->setEnabled(!autotuneCheckBox->isChecked());
+        prefetchSpinBox->setEnabled(true);
+        memoryMapCheckBox->setEnabled(true);
+        incrementalCheckBox->setEnabled(true);
+#ifdef __linux__
+        numaCheckBox->setEnabled(true);
+#endif
+        gdalProfileComboBox->setEnabled(true);
+        traversalComboBox->setEnabled(true);
+        targetSrsLineEdit->setEnabled(true);
+        resolutionSpinBox->setEnabled(true);
+        resamplingComboBox->setEnabled(true);
+        scaleSpinBox->setEnabled(true);
+        outputWidthSpinBox->setEnabled(true);
+        outputHeightSpinBox->setEnabled(true);
+        resizeKernelComboBox->setEnabled(true);
+        bandMathLineEdit->setEnabled(true);
+        bandSelectionLineEdit->setEnabled(true);
+        subsetComboBox->setEnabled(true);
+        tileModeComboBox->setEnabled(true);
+        tileFormatComboBox->setEnabled(true);
+        minZoomSpinBox->setEnabled(true);
+        maxZoomSpinBox->setEnabled(true);
+        splitColumnsSpinBox->setEnabled(true);
+        splitRowsSpinBox->setEnabled(true);
+        splitChunkSpinBox->setEnabled(true);
+        updateSubsetField();
+        updateMosaicLabel();
+#ifdef HAVE_IO_URING
+        ioUringCheckBox->setEnabled(true);
+#endif
 
         etaLabel->setText("ETA: N/A");
 
@@ -778,6 +6855,26 @@ private slots:
         thread = nullptr;
     }
 
+    void updateMosaicLabel()
+    {
+        bool mosaic = mosaicFiles.size() > 1;
+        mosaicLabel->setText(mosaic ? QString("+%1 more (mosaic)").arg(mosaicFiles.size() - 1) : QString());
+        mosaicLabel->setVisible(mosaic);
+        compositeComboBox->setEnabled(mosaic && startButton->isEnabled());
+    }
+
+    void updateSubsetField()
+    {
+        auto mode = static_cast<ConversionSettings::SubsetMode>(subsetComboBox->currentData().toInt());
+        subsetLineEdit->setEnabled(mode != ConversionSettings::NoSubset);
+        if (mode == ConversionSettings::PixelWindow)
+            subsetLineEdit->setPlaceholderText("xoff,yoff,xsize,ysize");
+        else if (mode == ConversionSettings::BoundingBox)
+            subsetLineEdit->setPlaceholderText("minx,miny,maxx,maxy (input CRS)");
+        else
+            subsetLineEdit->setPlaceholderText(QString());
+    }
+
     void appendLog(const QString &message)
     {
         logWindow->append(message);
@@ -788,38 +6885,81 @@ private slots:
 
     void initializeGDAL()
     {
-        // Initialize GDAL
-        static std::once_flag gdalInitFlag;
-        std::call_once(gdalInitFlag, []() {
-            GDALAllRegister();
-        });
+        // The cached catalogue fills the driver lists straight away; GDAL
+        // itself is registered in the background and conversions wait for it
+        bool cached = DriverCatalogue::loadCached(drivers);
+        if (cached)
+            populateDrivers();
+        else
+            appendLog("Loading GDAL drivers...");
+        startButton->setEnabled(false);
 
-        // Populate input and output driver lists
-        int driverCount = GetGDALDriverManager()->GetDriverCount();
-        for (int i = 0; i < driverCount; ++i)
-        {
-            GDALDriver* driver = GetGDALDriverManager()->GetDriver(i);
-            if (driver)
-            {
-                const char* shortName = driver->GetDescription();
-                const char* longName = driver->GetMetadataItem(GDAL_DMD_LONGNAME);
+        driverThread = new QThread();
+        DriverLoader* loader = new DriverLoader(cached ? drivers : std::vector<DriverEntry>());
+        loader->moveToThread(driverThread);
 
-                // Only consider raster formats
-                if (driver->GetMetadataItem(GDAL_DCAP_RASTER) != nullptr)
+        connect(driverThread, &QThread::started, loader, &DriverLoader::process);
+        connect(driverThread, &QThread::finished, loader, &QObject::deleteLater);
+        // A cached list is usable as soon as GDAL is; the rescan only refreshes it
+        connect(loader, &DriverLoader::registered, this, [this, cached]() {
+            gdalReady = true;
+            if (cached)
+            {
+                startButton->setEnabled(true);
+                updateOptions(outputDriverComboBox->currentText());
+            }
+        });
+        connect(loader, &DriverLoader::scanned, this, [this, loader, cached](bool changed) {
+            if (changed)
+            {
+                // Keep the user's picks across a refresh of a stale cache
+                QString input = inputDriverComboBox->currentData().toString();
+                QString output = outputDriverComboBox->currentData().toString();
+                drivers = loader->drivers;
+                populateDrivers();
+                if (cached)
+                {
+                    inputDriverComboBox->setCurrentIndex(std::max(0, inputDriverComboBox->findData(input)));
+                    outputDriverComboBox->setCurrentIndex(std::max(0, outputDriverComboBox->findData(output)));
+                    appendLog(QString("Driver list refreshed: %1 raster drivers.").arg(drivers.size()));
+                }
+                else
                 {
-                    QString driverLabel = QString("%1 (%2)").arg(longName).arg(shortName);
-                    QVariant driverData(shortName);
+                    appendLog(QString("Found %1 raster drivers.").arg(drivers.size()));
+                }
+                updateOptions(outputDriverComboBox->currentText());
+            }
+            driverThread->quit();
+            if (!cached)
+                startButton->setEnabled(true);
+        });
 
-                    // Add to input driver combo box
-                    inputDriverComboBox->addItem(driverLabel, driverData);
+        driverThread->start();
+    }
 
-                    // Add to output driver combo box if creation is supported
-                    if (driver->GetMetadataItem(GDAL_DCAP_CREATE) != nullptr ||
-                        driver->GetMetadataItem(GDAL_DCAP_CREATECOPY) != nullptr)
-                    {
-                        outputDriverComboBox->addItem(driverLabel, driverData);
-                    }
-                }
+    // Fills both driver lists and the file dialog filters in one pass
+    void populateDrivers()
+    {
+        QStringList inputFilters("All Files (*)");
+        QStringList outputFilters("All Files (*)");
+
+        inputDriverComboBox->clear();
+        outputDriverComboBox->clear();
+        for (const DriverEntry& entry : drivers)
+        {
+            QString driverLabel = QString("%1 (%2)").arg(entry.longName).arg(entry.shortName);
+            QStringList extList = entry.extensions.split(' ', Qt::SkipEmptyParts);
+            QString pattern = extList.isEmpty() ? "*" : "*." + extList.join(" *.");
+            QString filter = QString("%1 (%2)").arg(entry.longName).arg(pattern);
+
+            inputDriverComboBox->addItem(driverLabel, QVariant(entry.shortName));
+            inputFilters.append(filter);
+
+            // Only drivers that can write are offered for output
+            if (entry.writable())
+            {
+                outputDriverComboBox->addItem(driverLabel, QVariant(entry.shortName));
+                outputFilters.append(filter);
             }
         }
 
@@ -827,234 +6967,139 @@ private slots:
         inputDriverComboBox->setCurrentIndex(0);
         outputDriverComboBox->setCurrentIndex(0);
 
-        // Build file filters for file dialogs
-        inputFileFilter = buildFileFilter(true);
-        outputFileFilter = buildFileFilter(false);
+        inputFileFilter = inputFilters.join(";;");
+        outputFileFilter = outputFilters.join(";;");
     }
 
-    QString buildFileFilter(bool forInput)
+    const DriverEntry* findDriver(const QString& shortName) const
     {
-        QStringList filters;
-        int driverCount = GetGDALDriverManager()->GetDriverCount();
-        for (int i = 0; i < driverCount; ++i)
+        for (const DriverEntry& entry : drivers)
         {
-            GDALDriver* driver = GetGDALDriverManager()->GetDriver(i);
-            if (driver)
-            {
-                const char* longName = driver->GetMetadataItem(GDAL_DMD_LONGNAME);
-
-                // Only consider raster formats
-                if (driver->GetMetadataItem(GDAL_DCAP_RASTER) != nullptr)
-                {
-                    // For output, only include drivers that support creation
-                    if (!forInput)
-                    {
-                        if (driver->GetMetadataItem(GDAL_DCAP_CREATE) == nullptr &&
-                            driver->GetMetadataItem(GDAL_DCAP_CREATECOPY) == nullptr)
-                        {
-                            continue;
-                        }
-                    }
-
-                    const char* extensions = driver->GetMetadataItem(GDAL_DMD_EXTENSIONS);
-                    if (extensions)
-                    {
-                        QStringList extList = QString(extensions).split(' ', Qt::SkipEmptyParts);
-                        QString pattern = extList.isEmpty() ? "*" : "*." + extList.join(" *.");
-                        QString filter = QString("%1 (%2)").arg(longName).arg(pattern);
-                        filters.append(filter);
-                    }
-                    else
-                    {
-                        filters.append(QString("%1 (*)").arg(longName));
-                    }
-                }
-            }
+            if (entry.shortName == shortName)
+                return &entry;
         }
-
-        filters.prepend("All Files (*)");
-        return filters.join(";;");
+        return nullptr;
     }
 
     void updateOptions(const QString& driverLabel)
     {
-        // Clear existing options
-        clearLayout(optionsLayout);
+        // Option lists need the driver itself, which may still be loading
+        if (!gdalReady)
+            return;
 
-        // Get selected driver
+        // Panels are built the first time a driver is selected and kept, so
+        // switching back keeps the values entered
         QString driverName = outputDriverComboBox->currentData().toString();
-        GDALDriver* driver = GetGDALDriverManager()->GetDriverByName(driverName.toStdString().c_str());
+        QWidget* panel = optionPanels.value(driverName);
+        if (!panel)
+        {
+            panel = buildOptionPanel(creationOptions(driverName));
+            optionPanels.insert(driverName, panel);
+            optionsLayout->addWidget(panel);
+        }
 
-        if (!driver)
-            return;
+        if (currentOptionPanel && currentOptionPanel != panel)
+            currentOptionPanel->hide();
+        panel->show();
+        currentOptionPanel = panel;
+
+        optionsGroup->updateGeometry(); // Refresh the options group layout
+    }
+
+    // Parsed once per driver; the GTiff and COG lists are large
+    const std::vector<CreationOption>& creationOptions(const QString& driverName)
+    {
+        auto it = optionSchemas.find(driverName);
+        if (it == optionSchemas.end())
+        {
+            GDALDriver* driver = GetGDALDriverManager()->GetDriverByName(driverName.toStdString().c_str());
+            const char* optionList = driver ? driver->GetMetadataItem(GDAL_DMD_CREATIONOPTIONLIST) : nullptr;
+            it = optionSchemas.insert(driverName, parseCreationOptions(optionList));
+        }
+        return it.value();
+    }
 
-        // Get driver-specific options
-        const char* optionList = driver->GetMetadataItem(GDAL_DMD_CREATIONOPTIONLIST);
-        if (optionList)
+    QWidget* buildOptionPanel(const std::vector<CreationOption>& schema)
+    {
+        QWidget* panel = new QWidget();
+        QVBoxLayout* panelLayout = new QVBoxLayout();
+        panelLayout->setContentsMargins(0, 0, 0, 0);
+        panel->setLayout(panelLayout);
+
+        for (const CreationOption& option : schema)
         {
-            CPLXMLNode* psNode = CPLParseXMLString(optionList);
-            if (psNode)
+            QHBoxLayout* optionLayout = new QHBoxLayout();
+            QLabel* optionLabel = new QLabel(QString("%1 (%2):").arg(option.name).arg(option.type));
+
+            QWidget* inputWidget = nullptr;
+            bool hasDefault = !option.defaultValue.isEmpty();
+
+            if (option.type == "boolean")
             {
-                CPLXMLNode* psChild = psNode->psChild;
-                while (psChild)
-                {
-                    if (EQUAL(psChild->pszValue, "Option"))
-                    {
-                        const char* optionName = CPLGetXMLValue(psChild, "name", nullptr);
-                        const char* optionType = CPLGetXMLValue(psChild, "type", "string");
-                        const char* defaultValue = CPLGetXMLValue(psChild, "default", nullptr);
-                        const char* description = CPLGetXMLValue(psChild, "description", "");
-                        const char* values = CPLGetXMLValue(psChild, "values", nullptr);
-
-                        if (optionName)
-                        {
-                            QHBoxLayout* optionLayout = new QHBoxLayout();
-                            QLabel* optionLabel = new QLabel(QString("%1 (%2):").arg(optionName).arg(optionType));
-
-                            QWidget* inputWidget = nullptr;
-
-                            if (EQUAL(optionType, "boolean"))
-                            {
-                                QCheckBox* checkBox = new QCheckBox();
-                                checkBox->setProperty("optionKey", optionName);
-                                if (defaultValue)
-                                {
-                                    checkBox->setChecked(EQUAL(defaultValue, "YES") || EQUAL(defaultValue, "TRUE") || EQUAL(defaultValue, "1"));
-                                }
-                                else
-                                {
-                                    checkBox->setChecked(false); // Default to unchecked if no default value
-                                }
-                                inputWidget = checkBox;
-                            }
-                            else if (EQUAL(optionType, "int") || EQUAL(optionType, "uint"))
-                            {
-                                QSpinBox* spinBox = new QSpinBox();
-                                spinBox->setProperty("optionKey", optionName);
-                                int minValue = QString(CPLGetXMLValue(psChild, "min", QString::number(std::numeric_limits<int>::min()).toStdString().c_str())).toInt();
-                                int maxValue = QString(CPLGetXMLValue(psChild, "max", QString::number(std::numeric_limits<int>::max()).toStdString().c_str())).toInt();
-                                spinBox->setRange(minValue, maxValue);
-                                if (defaultValue)
-                                {
-                                    spinBox->setValue(QString(defaultValue).toInt());
-                                }
-                                inputWidget = spinBox;
-                            }
-                            else if (EQUAL(optionType, "float") || EQUAL(optionType, "double"))
-                            {
-                                QDoubleSpinBox* doubleSpinBox = new QDoubleSpinBox();
-                                doubleSpinBox->setProperty("optionKey", optionName);
-                                double minValue = QString(CPLGetXMLValue(psChild, "min", QString::number(-std::numeric_limits<double>::max()).toStdString().c_str())).toDouble();
-                                double maxValue = QString(CPLGetXMLValue(psChild, "max", QString::number(std::numeric_limits<double>::max()).toStdString().c_str())).toDouble();
-                                doubleSpinBox->setRange(minValue, maxValue);
-                                doubleSpinBox->setDecimals(6);
-                                if (defaultValue)
-                                {
-                                    doubleSpinBox->setValue(QString(defaultValue).toDouble());
-                                }
-                                inputWidget = doubleSpinBox;
-                            }
-                            else if (EQUAL(optionType, "string"))
-                            {
-                                // Check if there are enumerated values
-                                CPLXMLNode* psValueNode = psChild->psChild;
-                                bool hasEnumValues = false;
-                                QStringList enumValues;
-                                while (psValueNode)
-                                {
-                                    if (EQUAL(psValueNode->pszValue, "Value"))
-                                    {
-                                        const char* valueString = CPLGetXMLValue(psValueNode, nullptr, "");
-                                        enumValues.append(valueString);
-                                        hasEnumValues = true;
-                                    }
-                                    psValueNode = psValueNode->psNext;
-                                }
-
-                                if (hasEnumValues)
-                                {
-                                    QComboBox* comboBox = new QComboBox();
-                                    comboBox->setProperty("optionKey", optionName);
-                                    comboBox->addItems(enumValues);
-                                    if (defaultValue)
-                                    {
-                                        int defaultIndex = comboBox->findText(defaultValue);
-                                        if (defaultIndex != -1)
-                                        {
-                                            comboBox->setCurrentIndex(defaultIndex);
-                                        }
-                                    }
-                                    inputWidget = comboBox;
-                                }
-                                else
-                                {
-                                    QLineEdit* lineEdit = new QLineEdit();
-                                    lineEdit->setProperty("optionKey", optionName);
-                                    if (defaultValue)
-                                    {
-                                        lineEdit->setText(defaultValue);
-                                    }
-                                    inputWidget = lineEdit;
-                                }
-                            }
-                            else
-                            {
-                                // Fallback to QLineEdit for unknown types
-                                QLineEdit* lineEdit = new QLineEdit();
-                                lineEdit->setProperty("optionKey", optionName);
-                                if (defaultValue)
-                                {
-                                    lineEdit->setText(defaultValue);
-                                }
-                                inputWidget = lineEdit;
-                            }
-
-                            // Optionally, you can add a tooltip with the description
-                            if (description && strlen(description) > 0)
-                            {
-                                inputWidget->setToolTip(description);
-                            }
-
-                            optionLayout->addWidget(optionLabel);
-                            optionLayout->addWidget(inputWidget);
-                            optionsLayout->addLayout(optionLayout);
-                        }
-                    }
-                    psChild = psChild->psNext;
-                }
-                CPLDestroyXMLNode(psNode);
+                QCheckBox* checkBox = new QCheckBox();
+                QString value = option.defaultValue.toUpper();
+                checkBox->setChecked(value == "YES" || value == "TRUE" || value == "1"); // Unchecked without a default
+                inputWidget = checkBox;
+            }
+            else if (option.type == "int" || option.type == "uint")
+            {
+                QSpinBox* spinBox = new QSpinBox();
+                int minValue = option.minValue.isEmpty() ? std::numeric_limits<int>::min() : option.minValue.toInt();
+                int maxValue = option.maxValue.isEmpty() ? std::numeric_limits<int>::max() : option.maxValue.toInt();
+                spinBox->setRange(minValue, maxValue);
+                if (hasDefault)
+                    spinBox->setValue(option.defaultValue.toInt());
+                inputWidget = spinBox;
+            }
+            else if (option.type == "float" || option.type == "double")
+            {
+                QDoubleSpinBox* doubleSpinBox = new QDoubleSpinBox();
+                double minValue = option.minValue.isEmpty() ? -std::numeric_limits<double>::max() : option.minValue.toDouble();
+                double maxValue = option.maxValue.isEmpty() ? std::numeric_limits<double>::max() : option.maxValue.toDouble();
+                doubleSpinBox->setRange(minValue, maxValue);
+                doubleSpinBox->setDecimals(6);
+                if (hasDefault)
+                    doubleSpinBox->setValue(option.defaultValue.toDouble());
+                inputWidget = doubleSpinBox;
+            }
+            else if (option.type == "string" && !option.values.isEmpty())
+            {
+                QComboBox* comboBox = new QComboBox();
+                comboBox->addItems(option.values);
+                int defaultIndex = hasDefault ? comboBox->findText(option.defaultValue) : -1;
+                if (defaultIndex != -1)
+                    comboBox->setCurrentIndex(defaultIndex);
+                inputWidget = comboBox;
+            }
+            else
+            {
+                // Free text, also used for unknown types
+                QLineEdit* lineEdit = new QLineEdit();
+                lineEdit->setText(option.defaultValue);
+                inputWidget = lineEdit;
             }
-        }
 
-        optionsGroup->updateGeometry(); // Refresh the options group layout
+            inputWidget->setProperty("optionKey", option.name);
+            if (!option.description.isEmpty())
+                inputWidget->setToolTip(option.description);
+
+            optionLayout->addWidget(optionLabel);
+            optionLayout->addWidget(inputWidget);
+            panelLayout->addLayout(optionLayout);
+        }
+        return panel;
     }
 
     void updateOutputFileExtension()
     {
         // Get the selected driver
-        QString driverName = outputDriverComboBox->currentData().toString();
-        GDALDriver* driver = GetGDALDriverManager()->GetDriverByName(driverName.toStdString().c_str());
+        const DriverEntry* driver = findDriver(outputDriverComboBox->currentData().toString());
 
         if (!driver)
             return;
 
-        const char* extensions = driver->GetMetadataItem(GDAL_DMD_EXTENSIONS);
-        QString defaultExtension;
-
-        if (extensions)
-        {
-            // Get the first extension from the list
-            QStringList extList = QString(extensions).split(' ', Qt::SkipEmptyParts);
-            if (!extList.isEmpty())
-                defaultExtension = extList.first();
-        }
-        else
-        {
-            // Fallback to GDAL_DMD_EXTENSION
-            const char* extension = driver->GetMetadataItem(GDAL_DMD_EXTENSION);
-            if (extension)
-                defaultExtension = QString(extension);
-        }
+        // The first listed extension is the default
+        QString defaultExtension = driver->extensions.section(' ', 0, 0);
 
         if (!defaultExtension.isEmpty())
         {
@@ -1091,25 +7136,6 @@ private slots:
     }
 
 private:
-    void clearLayout(QLayout* layout)
-    {
-        if (!layout)
-            return;
-        while (QLayoutItem* item = layout->takeAt(0))
-        {
-            if (QWidget* widget = item->widget())
-            {
-                widget->deleteLater();
-            }
-            else if (QLayout* childLayout = item->layout())
-            {
-                clearLayout(childLayout);
-                childLayout->deleteLater();
-            }
-            delete item;
-        }
-    }
-
     QLineEdit *inputLineEdit;
     QLineEdit *outputLineEdit;
     QPushButton *startButton;
@@ -1124,6 +7150,9 @@ private:
     QCheckBox *useOptionsCheckBox;
     QGroupBox *optionsGroup;
     QVBoxLayout *optionsLayout;
+    QMap<QString, std::vector<CreationOption>> optionSchemas;
+    QMap<QString, QWidget*> optionPanels;
+    QWidget* currentOptionPanel = nullptr;
 
     QString inputFileFilter;
     QString outputFileFilter;
@@ -1133,17 +7162,385 @@ private:
     Worker *worker;
     QThread *thread;
 
+    std::vector<DriverEntry> drivers;
+    QThread* driverThread = nullptr;
+    bool gdalReady = false;
+
     QRadioButton* cpuRadioButton;
-    QRadioButton* gpuRadioButton;
+    QRadioButton* simdRadioButton;
 
     QSpinBox* cpuCoresSpinBox;
+    QSpinBox* blockSizeSpinBox;
+    QCheckBox* autotuneCheckBox;
+    QSpinBox* prefetchSpinBox;
+    QCheckBox* memoryMapCheckBox;
+    QCheckBox* incrementalCheckBox;
+#ifdef __linux__
+    QCheckBox* numaCheckBox;
+#endif
+    QComboBox* gdalProfileComboBox;
+    QComboBox* traversalComboBox;
+
+    QLineEdit* targetSrsLineEdit;
+    QDoubleSpinBox* resolutionSpinBox;
+    QComboBox* resamplingComboBox;
+
+    QDoubleSpinBox* scaleSpinBox;
+    QSpinBox* outputWidthSpinBox;
+    QSpinBox* outputHeightSpinBox;
+    QComboBox* resizeKernelComboBox;
+    QLineEdit* bandMathLineEdit;
+    QLineEdit* bandSelectionLineEdit;
+    QComboBox* subsetComboBox;
+    QLineEdit* subsetLineEdit;
+
+    QStringList mosaicFiles;
+    QLabel* mosaicLabel;
+    QComboBox* compositeComboBox;
+
+    QComboBox* tileModeComboBox;
+    QComboBox* tileFormatComboBox;
+    QSpinBox* minZoomSpinBox;
+    QSpinBox* maxZoomSpinBox;
+
+    QSpinBox* splitColumnsSpinBox;
+    QSpinBox* splitRowsSpinBox;
+    QSpinBox* splitChunkSpinBox;
+#ifdef HAVE_IO_URING
+    QCheckBox* ioUringCheckBox;
+#endif
 };
 
 #include "main.moc"
 
+// The executable uses the Windows GUI subsystem, which starts without a
+// console, so headless modes attach to the console of the shell that
+// launched them; streams redirected to a file or pipe are left alone
+static void attachParentConsole()
+{
+#ifdef _WIN32
+    bool outRedirected = GetFileType(GetStdHandle(STD_OUTPUT_HANDLE)) != FILE_TYPE_UNKNOWN;
+    bool errRedirected = GetFileType(GetStdHandle(STD_ERROR_HANDLE)) != FILE_TYPE_UNKNOWN;
+    if ((outRedirected && errRedirected) || !AttachConsole(ATTACH_PARENT_PROCESS))
+        return;
+
+    FILE* stream = nullptr;
+    if (!outRedirected && freopen_s(&stream, "CONOUT$", "w", stdout) == 0)
+        std::cout.clear();
+    if (!errRedirected && freopen_s(&stream, "CONOUT$", "w", stderr) == 0)
+        std::cerr.clear();
+#endif
+}
+
+// Service mode: --daemon [<socket>] [--cores N] [--memory-mb M]
+//   [--watch DIR ... --watch-output DIR [--watch-driver NAME]
+//    [--watch-jobs N] [--watch-settle-ms MS]]
+static int runDaemon(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("GDALRasterConverter");
+    QCoreApplication::setApplicationName("GDALRasterConverter");
+
+    QString socketPath;
+    int cores = QThread::idealThreadCount();
+    qint64 memoryMB = static_cast<qint64>(CPLGetUsablePhysicalRAM() / 2 / (1024 * 1024));
+    if (memoryMB <= 0)
+        memoryMB = 4096;
+
+    QStringList watchDirs;
+    QString watchOutput;
+    QString watchDriver = "GTiff";
+    int watchJobs = 2;
+    int watchSettleMs = 2000;
+
+    QStringList args = QCoreApplication::arguments();
+    for (int i = 1; i < args.size(); ++i)
+    {
+        bool hasValue = i + 1 < args.size() && !args[i + 1].startsWith("--");
+        if (args[i] == "--daemon" && hasValue)
+            socketPath = args[++i];
+        else if (args[i] == "--cores" && hasValue)
+            cores = args[++i].toInt();
+        else if (args[i] == "--memory-mb" && hasValue)
+            memoryMB = args[++i].toLongLong();
+        else if (args[i] == "--watch" && hasValue)
+            watchDirs << QDir(args[++i]).absolutePath();
+        else if (args[i] == "--watch-output" && hasValue)
+            watchOutput = QDir(args[++i]).absolutePath();
+        else if (args[i] == "--watch-driver" && hasValue)
+            watchDriver = args[++i];
+        else if (args[i] == "--watch-jobs" && hasValue)
+            watchJobs = args[++i].toInt();
+        else if (args[i] == "--watch-settle-ms" && hasValue)
+            watchSettleMs = args[++i].toInt();
+    }
+
+    // Converting into a watched folder would feed outputs back in
+    bool watchUsable = !watchDirs.isEmpty() && !watchOutput.isEmpty() && !watchDirs.contains(watchOutput);
+    if ((socketPath.isEmpty() && watchDirs.isEmpty()) || (!watchDirs.isEmpty() && !watchUsable))
+    {
+        std::cerr << "Usage: GDALRasterConverter --daemon [<socket>] [--cores N] [--memory-mb M]\n"
+                     "         [--watch DIR ... --watch-output DIR [--watch-driver NAME] [--watch-jobs N] [--watch-settle-ms MS]]\n"
+                     "The watch output directory must not be one of the watched directories."
+                  << std::endl;
+        return 2;
+    }
+
+    GDALAllRegister();
+
+    ConversionDaemon daemon(cores, memoryMB);
+    QString error;
+    if (!socketPath.isEmpty())
+    {
+        if (!daemon.listen(socketPath, error))
+        {
+            std::cerr << "Cannot listen on " << socketPath.toStdString() << ": " << error.toStdString() << std::endl;
+            return 1;
+        }
+        std::cerr << "Listening on " << socketPath.toStdString() << " with " << cores << " core(s) and " << memoryMB << " MB." << std::endl;
+    }
+
+    std::unique_ptr<FolderWatcher> folderWatcher;
+    if (!watchDirs.isEmpty())
+    {
+        if (!ConversionDaemon::isWritableDriver(watchDriver))
+        {
+            std::cerr << "Output driver cannot write: " << watchDriver.toStdString() << std::endl;
+            return 2;
+        }
+        if (!QDir().mkpath(watchOutput))
+        {
+            std::cerr << "Cannot create " << watchOutput.toStdString() << std::endl;
+            return 1;
+        }
+
+        folderWatcher = std::make_unique<FolderWatcher>(daemon, watchOutput, watchDriver, watchJobs, watchSettleMs);
+        if (!folderWatcher->watch(watchDirs))
+            return 1;
+        for (const QString& dir : watchDirs)
+            std::cerr << "Watching " << dir.toStdString() << " -> " << watchOutput.toStdString() << std::endl;
+    }
+
+    return app.exec();
+}
+
+// Runs one conversion in the calling thread, logging to stderr
+static bool convertHeadless(const QString& input, const QString& output, const QString& driver, const QMap<QString, QString>& options,
+                            const ConversionSettings& settings, int threads)
+{
+    Worker worker(input, output, QString(), driver, options, Worker::SIMD, threads, settings);
+    bool ok = false;
+    QObject::connect(&worker, &Worker::logMessage, [](const QString& message) {
+        std::cerr << message.toStdString() << std::endl;
+    });
+    QObject::connect(&worker, &Worker::finished, [&ok](bool success, const QString& message) {
+        ok = success;
+        std::cerr << message.toStdString() << std::endl;
+    });
+    worker.process();
+    return ok;
+}
+
+// Sharded conversion for rasters too large for one machine. The output
+// is cut into bands of rows; each shard converts one band into a part file
+// and a final step assembles the parts:
+//   --shard I/N --input IN --output PART [--driver D] [--options JSON] [--settings JSON] [--threads T]
+//       converts shard I (0-based) of N; a cluster scheduler runs one per node
+//   --merge-shards --output OUT [--driver D] [--options JSON] PART...
+//       builds a VRT over the parts, or copies them into one file (GTiff, COG)
+//   --run-shards N --input IN --output OUT [--driver D] [--options JSON] [--settings JSON]
+//       runs N local shard processes standing in for nodes, then merges
+static int runShards(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("GDALRasterConverter");
+    QCoreApplication::setApplicationName("GDALRasterConverter");
+
+    QString mode, input, output, driver = "GTiff", optionsJson, settingsJson;
+    int shardIndex = 0, shardCount = 0;
+    int threads = QThread::idealThreadCount();
+    QStringList parts;
+
+    QStringList args = QCoreApplication::arguments();
+    for (int i = 1; i < args.size(); ++i)
+    {
+        QString arg = args[i];
+        bool hasValue = i + 1 < args.size();
+        if (arg == "--shard" && hasValue)
+        {
+            mode = arg;
+            QStringList fields = args[++i].split('/');
+            shardIndex = fields.value(0).toInt();
+            shardCount = fields.value(1).toInt();
+        }
+        else if (arg == "--run-shards" && hasValue)
+        {
+            mode = arg;
+            shardCount = args[++i].toInt();
+        }
+        else if (arg == "--merge-shards")
+            mode = arg;
+        else if (arg == "--input" && hasValue)
+            input = args[++i];
+        else if (arg == "--output" && hasValue)
+            output = args[++i];
+        else if (arg == "--driver" && hasValue)
+            driver = args[++i];
+        else if (arg == "--options" && hasValue)
+            optionsJson = args[++i];
+        else if (arg == "--settings" && hasValue)
+            settingsJson = args[++i];
+        else if (arg == "--threads" && hasValue)
+            threads = std::max(1, args[++i].toInt());
+        else if (!arg.startsWith("--"))
+            parts << arg;
+        else
+        {
+            std::cerr << "Unknown argument: " << arg.toStdString() << std::endl;
+            return 2;
+        }
+    }
+
+    // Only a merge takes part files on the command line
+    bool valid = !output.isEmpty() && (mode == "--merge-shards" ? !parts.isEmpty()
+                                                                : parts.isEmpty() && !input.isEmpty() && shardCount > 0 && shardIndex >= 0 && shardIndex < shardCount);
+    if (!valid)
+    {
+        std::cerr << "Usage: GDALRasterConverter --shard I/N --input IN --output PART [--driver D] [--options JSON] [--settings JSON] [--threads T]\n"
+                     "       GDALRasterConverter --merge-shards --output OUT [--driver D] [--options JSON] PART...\n"
+                     "       GDALRasterConverter --run-shards N --input IN --output OUT [--driver D] [--options JSON] [--settings JSON]"
+                  << std::endl;
+        return 2;
+    }
+
+    QMap<QString, QString> options;
+    QJsonObject optionsObject = QJsonDocument::fromJson(optionsJson.toUtf8()).object();
+    for (auto it = optionsObject.begin(); it != optionsObject.end(); ++it)
+        options.insert(it.key(), it.value().toVariant().toString());
+
+    ConversionSettings settings;
+    QString error;
+    if (!ConversionDaemon::settingsFromJson(QJsonDocument::fromJson(settingsJson.toUtf8()).object(), settings, error))
+    {
+        std::cerr << error.toStdString() << std::endl;
+        return 2;
+    }
+
+    GDALAllRegister();
+
+    // Ctrl+C (or a scheduler's SIGTERM) stops the final copy cleanly
+    // instead of leaving a truncated merged output behind
+    static std::atomic<bool> merging{true};
+    auto stopMerge = [](int) { merging.store(false); };
+
+    if (mode == "--shard")
+    {
+        settings.shardIndex = shardIndex;
+        settings.shardCount = shardCount;
+        return convertHeadless(input, output, driver, options, settings, threads) ? 0 : 1;
+    }
+
+    if (mode == "--run-shards")
+    {
+        // Fail before any shard runs when the parts could not be merged.
+        // A reprojected output is always north-up; otherwise the input's
+        // georeference carries through subsets and resizing
+        if (settings.targetSrs.trimmed().isEmpty())
+        {
+            GDALDataset* poInput = static_cast<GDALDataset*>(GDALOpenEx(input.toStdString().c_str(), GDAL_OF_RASTER | GDAL_OF_READONLY, nullptr, nullptr, nullptr));
+            if (!poInput)
+            {
+                std::cerr << "Failed to open input file: " << input.toStdString() << std::endl;
+                return 1;
+            }
+            bool northUp = RasterGrid::fromDataset(poInput, {}).northUp();
+            GDALClose(poInput);
+            if (!northUp)
+            {
+                std::cerr << "Shard parts are merged by georeference, so the input must be georeferenced without rotation; "
+                             "set a target CRS in --settings or convert without sharding."
+                          << std::endl;
+                return 1;
+            }
+        }
+
+        // Parts are tiled GTiffs next to the output; for a VRT output they
+        // are the final data and take the creation options
+        bool toVrt = driver.compare("VRT", Qt::CaseInsensitive) == 0;
+        QFileInfo outputInfo(output);
+        QString partOptions = toVrt ? optionsJson : QString("{\"TILED\":\"YES\",\"BIGTIFF\":\"IF_SAFER\"}");
+
+        std::vector<std::unique_ptr<QProcess>> shards;
+        for (int i = 0; i < shardCount; ++i)
+        {
+            parts << outputInfo.dir().filePath(QString("%1.part%2.tif").arg(outputInfo.completeBaseName()).arg(i));
+            auto shard = std::make_unique<QProcess>();
+            shard->setProcessChannelMode(QProcess::ForwardedChannels);
+            shard->start(QCoreApplication::applicationFilePath(),
+                         {"--shard", QString("%1/%2").arg(i).arg(shardCount), "--input", input, "--output", parts.last(), "--driver", "GTiff",
+                          "--options", partOptions, "--settings", settingsJson, "--threads", QString::number(std::max(1, threads / shardCount))});
+            shards.push_back(std::move(shard));
+        }
+
+        bool ok = true;
+        for (auto& shard : shards)
+        {
+            shard->waitForFinished(-1);
+            ok = ok && shard->exitStatus() == QProcess::NormalExit && shard->exitCode() == 0;
+        }
+        if (!ok)
+        {
+            std::cerr << "A shard failed; parts are left in place." << std::endl;
+            return 1;
+        }
+
+        std::signal(SIGINT, stopMerge);
+        std::signal(SIGTERM, stopMerge);
+        if (!mergeShards(parts, output, driver, options, error, &merging))
+        {
+            std::cerr << error.toStdString() << std::endl;
+            return 1;
+        }
+        for (const QString& part : parts)
+        {
+            QFile::remove(emptyShardMarker(part));
+            if (!toVrt)
+                QFile::remove(part);
+        }
+        std::cerr << "Merged " << shardCount << " shard(s) into " << output.toStdString() << std::endl;
+        return 0;
+    }
+
+    std::signal(SIGINT, stopMerge);
+    std::signal(SIGTERM, stopMerge);
+    if (!mergeShards(parts, output, driver, options, error, &merging))
+    {
+        std::cerr << error.toStdString() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--daemon")
+        {
+            attachParentConsole();
+            return runDaemon(argc, argv);
+        }
+        if (arg == "--shard" || arg == "--run-shards" || arg == "--merge-shards")
+        {
+            attachParentConsole();
+            return runShards(argc, argv);
+        }
+    }
+
     QApplication app(argc, argv);
+    QApplication::setOrganizationName("GDALRasterConverter");
+    QApplication::setApplicationName("GDALRasterConverter");
 
     MainWindow window;
     window.resize(800, 600); // Adjusted size to accommodate additional UI elements